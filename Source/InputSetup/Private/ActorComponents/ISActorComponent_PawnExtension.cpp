@@ -4,23 +4,61 @@
 
 #include "GCUtils_UObjectSystem.h"
 #include "GameFramework/Pawn.h"
+#include "Engine/World.h"
+#include "TimerManager.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "InputMappingContext.h"
+#include "InputAction.h"
+#include "ISEngineSubsystem_InputActionAssetReferences.h"
 #include "GCUtils_Log.h"
 #include "GCUtils_String.h"
+#include "ISStats.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogISActorComponent_PawnExtension, Log, All);
 
+namespace
+{
+    FISPossessionPrewarmStats PossessionPrewarmStats;
+}
+
 UISActorComponent_PawnExtension::UISActorComponent_PawnExtension(const FObjectInitializer& ObjectInitializer)
     : Super(ObjectInitializer)
 {
     PrimaryComponentTick.bCanEverTick = false;
+
+    bIsListeningForInputActionChanges = false;
+    bIsInputMappingContextTagRulesUpdatePending = false;
+    bIsPrewarmedForPossession = false;
+}
+
+void UISActorComponent_PawnExtension::EndPlay(const EEndPlayReason::Type inEndPlayReason)
+{
+    UnbindInputActions();
+
+    if (const UWorld* world = GetWorld())
+    {
+        world->GetTimerManager().ClearTimer(InputMappingContextTagRulesUpdateTimerHandle);
+    }
+
+    bIsInputMappingContextTagRulesUpdatePending = false;
+
+    Super::EndPlay(inEndPlayReason);
 }
 
 void UISActorComponent_PawnExtension::OnOwnerPawnClientRestart()
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISActorComponent_PawnExtension::OnOwnerPawnClientRestart);
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(UISActorComponent_PawnExtension::OnOwnerPawnClientRestart, InputSetupChannel);
+    LLM_SCOPE_BYTAG(InputSetup_PawnExtension);
+    SCOPE_CYCLE_COUNTER(STAT_ISOnOwnerPawnClientRestart);
+
+    const double startTime = FPlatformTime::Seconds();
+    ON_SCOPE_EXIT
+    {
+        FISStats::Get().RecordOwnerPawnClientRestart(
+            FPlatformTime::Seconds() - startTime,
+            InputMappingContextsToAdd.Num() + AppliedInputMappingContextTagRules.CountSetBits());
+    };
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -28,6 +66,8 @@ void UISActorComponent_PawnExtension::OnOwnerPawnClientRestart()
         Log,
         TEXT("On owner pawn client restart. Attempting to add input mapping contexts."));
 
+    RecordPossessionPrewarmResult();
+
     check(IsValid(GetOwner()));
     const APawn& owningPawn = GCUtils::UObjectSystem::CastChecked<APawn&>(GetOwner());
 
@@ -75,4 +115,515 @@ void UISActorComponent_PawnExtension::OnOwnerPawnClientRestart()
             inputMappingContextAddArgs.Priority,
             inputMappingContextAddArgs.ModifyContextOptions);
     }
+
+    // All mappings were cleared, so re-apply the tag rules that match now rather than waiting for the next tick.
+    AppliedInputMappingContextTagRules.Init(false, InputMappingContextTagRules.Num());
+    UpdateInputMappingContextTagRules();
+
+    BindInputActions();
+}
+
+void UISActorComponent_PawnExtension::PrewarmForUpcomingPossession()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISActorComponent_PawnExtension::PrewarmForUpcomingPossession);
+    LLM_SCOPE_BYTAG(InputSetup_PawnExtension);
+
+    if (bIsPrewarmedForPossession)
+    {
+        return;
+    }
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISActorComponent_PawnExtension,
+        Verbose,
+        TEXT("Prewarming input for upcoming possession."));
+
+    bIsPrewarmedForPossession = true;
+
+    SyncInputActionBindingStates();
+
+    // Resolve now, and while at it listen for changes so anything registered between now and the restart gets resolved too.
+    StartListeningForInputActionChanges();
+
+    UISEngineSubsystem_InputActionAssetReferences& inputActionAssetReferences =
+        UISEngineSubsystem_InputActionAssetReferences::GetChecked(*GEngine);
+
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindings.Num(); ++bindingIndex)
+    {
+        if (!ResolveInputActionBinding(bindingIndex))
+        {
+            inputActionAssetReferences.PrioritizePendingInputActionRegistration(InputActionBindings[bindingIndex].InputActionTag);
+        }
+    }
+}
+
+void UISActorComponent_PawnExtension::CancelPossessionPrewarm()
+{
+    if (!bIsPrewarmedForPossession)
+    {
+        return;
+    }
+
+    bIsPrewarmedForPossession = false;
+
+    // Stop listening only if nothing is bound, since bound actions need their listeners.
+    if (!BoundEnhancedInputComponent.IsValid())
+    {
+        StopListeningForInputActionChanges();
+    }
+}
+
+const FISPossessionPrewarmStats& UISActorComponent_PawnExtension::GetPossessionPrewarmStats()
+{
+    return PossessionPrewarmStats;
+}
+
+void UISActorComponent_PawnExtension::SetOwnerGameplayTags(const FGameplayTagContainer& inOwnerGameplayTags)
+{
+    OwnerGameplayTags = inOwnerGameplayTags;
+    RequestInputMappingContextTagRulesUpdate();
+}
+
+void UISActorComponent_PawnExtension::OnOwnerGameplayTagCountChanged(const FGameplayTag inTag, int32 inNewCount)
+{
+    if (inNewCount > 0)
+    {
+        OwnerGameplayTags.AddTag(inTag);
+    }
+    else
+    {
+        OwnerGameplayTags.RemoveTag(inTag);
+    }
+
+    RequestInputMappingContextTagRulesUpdate();
+}
+
+UEnhancedInputLocalPlayerSubsystem* UISActorComponent_PawnExtension::GetEnhancedInputLocalPlayerSubsystem() const
+{
+    const APawn* owningPawn = Cast<APawn>(GetOwner());
+    if (!owningPawn)
+    {
+        return nullptr;
+    }
+
+    const APlayerController* playerController = Cast<APlayerController>(owningPawn->GetController());
+    if (!playerController)
+    {
+        return nullptr;
+    }
+
+    const ULocalPlayer* localPlayer = playerController->GetLocalPlayer();
+    if (!localPlayer)
+    {
+        return nullptr;
+    }
+
+    return localPlayer->GetSubsystem<UEnhancedInputLocalPlayerSubsystem>();
+}
+
+void UISActorComponent_PawnExtension::RequestInputMappingContextTagRulesUpdate()
+{
+    if (bIsInputMappingContextTagRulesUpdatePending || InputMappingContextTagRules.IsEmpty())
+    {
+        return;
+    }
+
+    const UWorld* world = GetWorld();
+    if (!world)
+    {
+        return;
+    }
+
+    bIsInputMappingContextTagRulesUpdatePending = true;
+    InputMappingContextTagRulesUpdateTimerHandle = world->GetTimerManager().SetTimerForNextTick(
+        FTimerDelegate::CreateUObject(this, &ThisClass::UpdateInputMappingContextTagRules));
+}
+
+void UISActorComponent_PawnExtension::UpdateInputMappingContextTagRules()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISActorComponent_PawnExtension::UpdateInputMappingContextTagRules);
+    LLM_SCOPE_BYTAG(InputSetup_PawnExtension);
+
+    bIsInputMappingContextTagRulesUpdatePending = false;
+
+    UEnhancedInputLocalPlayerSubsystem* enhancedInputLocalPlayerSubsystem = GetEnhancedInputLocalPlayerSubsystem();
+    if (!enhancedInputLocalPlayerSubsystem)
+    {
+        // Not locally controlled. Rules are applied on the next client restart.
+        return;
+    }
+
+    if (AppliedInputMappingContextTagRules.Num() != InputMappingContextTagRules.Num())
+    {
+        AppliedInputMappingContextTagRules.SetNum(InputMappingContextTagRules.Num(), false);
+    }
+
+    for (int32 ruleIndex = 0; ruleIndex < InputMappingContextTagRules.Num(); ++ruleIndex)
+    {
+        const FISInputMappingContextTagRule& rule = InputMappingContextTagRules[ruleIndex];
+
+        const bool shouldBeApplied = rule.DoesMatch(OwnerGameplayTags);
+        if (shouldBeApplied == AppliedInputMappingContextTagRules[ruleIndex])
+        {
+            continue;
+        }
+
+        AppliedInputMappingContextTagRules[ruleIndex] = shouldBeApplied;
+
+        const FISInputMappingContextAddArgs& inputMappingContextAddArgs = rule.InputMappingContextAddArgs;
+
+        // Never force an immediate rebuild so that all of our changes here result in a single rebuild of the player's mappings.
+        FModifyContextOptions modifyContextOptions = inputMappingContextAddArgs.ModifyContextOptions;
+        modifyContextOptions.bForceImmediately = false;
+
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISActorComponent_PawnExtension,
+            Verbose,
+            WriteToString<256>(
+                shouldBeApplied ? TEXT("Adding") : TEXT("Removing"),
+                TEXT(" input mapping context '"),
+                GCUtils::String::GetUObjectPathNameSafe(inputMappingContextAddArgs.InputMappingContext),
+                TEXT("' for owner gameplay tags.")
+                )
+            );
+
+        if (shouldBeApplied)
+        {
+            enhancedInputLocalPlayerSubsystem->AddMappingContext(
+                inputMappingContextAddArgs.InputMappingContext,
+                inputMappingContextAddArgs.Priority,
+                modifyContextOptions);
+        }
+        else
+        {
+            enhancedInputLocalPlayerSubsystem->RemoveMappingContext(
+                inputMappingContextAddArgs.InputMappingContext,
+                modifyContextOptions);
+        }
+    }
+}
+
+void UISActorComponent_PawnExtension::BindInputActions()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISActorComponent_PawnExtension::BindInputActions);
+    LLM_SCOPE_BYTAG(InputSetup_PawnExtension);
+
+    // Bindings from a previous restart may still be on the input component.
+    RemoveInputActionBindings();
+
+    UEnhancedInputComponent* enhancedInputComponent = GetOwnerEnhancedInputComponent();
+    if (!enhancedInputComponent)
+    {
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISActorComponent_PawnExtension,
+            Verbose,
+            TEXT("Owner pawn has no enhanced input component. Not binding input actions."));
+        return;
+    }
+
+    SyncInputActionBindingStates();
+
+    BoundEnhancedInputComponent = enhancedInputComponent;
+
+    StartListeningForInputActionChanges();
+
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindings.Num(); ++bindingIndex)
+    {
+        TryBindInputAction(bindingIndex, *enhancedInputComponent);
+    }
+}
+
+void UISActorComponent_PawnExtension::UnbindInputActions()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISActorComponent_PawnExtension::UnbindInputActions);
+
+    RemoveInputActionBindings();
+    StopListeningForInputActionChanges();
+    BoundEnhancedInputComponent = nullptr;
+}
+
+UEnhancedInputComponent* UISActorComponent_PawnExtension::GetOwnerEnhancedInputComponent() const
+{
+    const AActor* owner = GetOwner();
+    if (!owner)
+    {
+        return nullptr;
+    }
+
+    return Cast<UEnhancedInputComponent>(owner->InputComponent);
+}
+
+void UISActorComponent_PawnExtension::RemoveInputActionBindings()
+{
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindingStates.Num(); ++bindingIndex)
+    {
+        RemoveInputActionBinding(bindingIndex);
+    }
+}
+
+void UISActorComponent_PawnExtension::SyncInputActionBindingStates()
+{
+    bool areInSync = InputActionBindingStates.Num() == InputActionBindings.Num();
+    for (int32 bindingIndex = 0; areInSync && bindingIndex < InputActionBindings.Num(); ++bindingIndex)
+    {
+        areInSync = InputActionBindingStates[bindingIndex].InputActionTag == InputActionBindings[bindingIndex].InputActionTag;
+    }
+
+    if (areInSync)
+    {
+        return;
+    }
+
+    // The bindings changed since our states were made, so our bindings and listeners no longer line up with them.
+    RemoveInputActionBindings();
+    StopListeningForInputActionChanges();
+
+    // Don't keep any state, since an index may now be for a different binding.
+    InputActionBindingStates.Reset();
+    InputActionBindingStates.SetNum(InputActionBindings.Num(), EAllowShrinking::No);
+
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindings.Num(); ++bindingIndex)
+    {
+        InputActionBindingStates[bindingIndex].InputActionTag = InputActionBindings[bindingIndex].InputActionTag;
+    }
+}
+
+const UInputAction* UISActorComponent_PawnExtension::ResolveInputActionBinding(const int32 inBindingIndex)
+{
+    check(InputActionBindings.IsValidIndex(inBindingIndex));
+    check(InputActionBindingStates.IsValidIndex(inBindingIndex));
+
+    FISInputActionBindingState& bindingState = InputActionBindingStates[inBindingIndex];
+
+    const UInputAction* inputAction = bindingState.ResolvedInputAction.Get();
+    if (!inputAction)
+    {
+        inputAction = UISEngineSubsystem_InputActionAssetReferences::GetChecked(*GEngine).GetInputAction(bindingState.InputActionTag);
+        bindingState.ResolvedInputAction = inputAction;
+    }
+
+    return inputAction;
+}
+
+bool UISActorComponent_PawnExtension::AreAllInputActionBindingsResolved() const
+{
+    if (InputActionBindingStates.Num() != InputActionBindings.Num())
+    {
+        return InputActionBindings.IsEmpty();
+    }
+
+    for (const FISInputActionBindingState& bindingState : InputActionBindingStates)
+    {
+        if (!bindingState.ResolvedInputAction.IsValid())
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void UISActorComponent_PawnExtension::RecordPossessionPrewarmResult()
+{
+    if (!bIsPrewarmedForPossession)
+    {
+        ++PossessionPrewarmStats.NumNotPrewarmed;
+        return;
+    }
+
+    bIsPrewarmedForPossession = false;
+
+    const bool isHit = AreAllInputActionBindingsResolved();
+    if (isHit)
+    {
+        ++PossessionPrewarmStats.NumHits;
+    }
+    else
+    {
+        ++PossessionPrewarmStats.NumMisses;
+    }
+
+    const int32 numPrewarmed = PossessionPrewarmStats.NumHits + PossessionPrewarmStats.NumMisses;
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISActorComponent_PawnExtension,
+        Verbose,
+        WriteToString<256>(
+            TEXT("Possession prewarm "),
+            isHit ? TEXT("hit") : TEXT("miss"),
+            TEXT(". Hit rate: "),
+            numPrewarmed > 0 ? (100 * PossessionPrewarmStats.NumHits / numPrewarmed) : 0,
+            TEXT("% of "),
+            numPrewarmed,
+            TEXT(" prewarmed restarts.")
+            )
+        );
+}
+
+void UISActorComponent_PawnExtension::TryBindInputAction(const int32 inBindingIndex, UEnhancedInputComponent& inEnhancedInputComponent)
+{
+    check(InputActionBindings.IsValidIndex(inBindingIndex));
+    check(InputActionBindingStates.IsValidIndex(inBindingIndex));
+
+    const FISInputActionBindingArgs& bindingArgs = InputActionBindings[inBindingIndex];
+    FISInputActionBindingState& bindingState = InputActionBindingStates[inBindingIndex];
+
+    if (bindingState.bIsBound)
+    {
+        return;
+    }
+
+    const UInputAction* inputAction = ResolveInputActionBinding(inBindingIndex);
+    if (!inputAction)
+    {
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISActorComponent_PawnExtension,
+            Verbose,
+            WriteToString<256>(
+                TEXT("No input action registered for tag '"),
+                bindingArgs.InputActionTag.GetTagName(),
+                TEXT("' yet. Binding once it is.")
+                )
+            );
+        return;
+    }
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISActorComponent_PawnExtension,
+        Verbose,
+        WriteToString<256>(
+            TEXT("Binding input action '"),
+            GCUtils::String::GetUObjectPathName(*inputAction),
+            TEXT("' to function '"),
+            bindingArgs.FunctionName,
+            TEXT("'.")
+            )
+        );
+
+    const FEnhancedInputActionEventBinding& binding = inEnhancedInputComponent.BindAction(
+        inputAction,
+        bindingArgs.TriggerEvent,
+        GetOwner(),
+        bindingArgs.FunctionName);
+
+    bindingState.BindingHandle = binding.GetHandle();
+    bindingState.bIsBound = true;
+}
+
+void UISActorComponent_PawnExtension::RemoveInputActionBinding(const int32 inBindingIndex)
+{
+    check(InputActionBindingStates.IsValidIndex(inBindingIndex));
+    FISInputActionBindingState& bindingState = InputActionBindingStates[inBindingIndex];
+
+    if (!bindingState.bIsBound)
+    {
+        return;
+    }
+
+    if (UEnhancedInputComponent* enhancedInputComponent = BoundEnhancedInputComponent.Get())
+    {
+        enhancedInputComponent->RemoveBindingByHandle(bindingState.BindingHandle);
+    }
+
+    bindingState.BindingHandle = 0;
+    bindingState.bIsBound = false;
+}
+
+void UISActorComponent_PawnExtension::StartListeningForInputActionChanges()
+{
+    if (bIsListeningForInputActionChanges)
+    {
+        return;
+    }
+
+    UISEngineSubsystem_InputActionAssetReferences& inputActionAssetReferences =
+        UISEngineSubsystem_InputActionAssetReferences::GetChecked(*GEngine);
+
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindingStates.Num(); ++bindingIndex)
+    {
+        FISInputActionBindingState& bindingState = InputActionBindingStates[bindingIndex];
+        const FGameplayTag& inputActionTag = bindingState.InputActionTag;
+
+        bindingState.InputActionAddedListenerHandle = inputActionAssetReferences.AddInputActionAddedListener(
+            inputActionTag,
+            EGameplayTagMatchType::Explicit,
+            FISReferencedInputActionNativeDelegate::FDelegate::CreateUObject(this, &ThisClass::OnBindingInputActionAdded, bindingIndex));
+
+        bindingState.InputActionRemovedListenerHandle = inputActionAssetReferences.AddInputActionRemovedListener(
+            inputActionTag,
+            EGameplayTagMatchType::Explicit,
+            FISReferencedInputActionNativeDelegate::FDelegate::CreateUObject(this, &ThisClass::OnBindingInputActionRemoved, bindingIndex));
+    }
+
+    bIsListeningForInputActionChanges = true;
+}
+
+void UISActorComponent_PawnExtension::StopListeningForInputActionChanges()
+{
+    if (!bIsListeningForInputActionChanges)
+    {
+        return;
+    }
+
+    // The engine subsystem may already be gone during shutdown.
+    UISEngineSubsystem_InputActionAssetReferences* inputActionAssetReferences =
+        GEngine ? GEngine->GetEngineSubsystem<UISEngineSubsystem_InputActionAssetReferences>() : nullptr;
+
+    for (int32 bindingIndex = 0; bindingIndex < InputActionBindingStates.Num(); ++bindingIndex)
+    {
+        FISInputActionBindingState& bindingState = InputActionBindingStates[bindingIndex];
+
+        if (inputActionAssetReferences)
+        {
+            // Not the binding's current tag, which may have changed since we started listening.
+            const FGameplayTag& inputActionTag = bindingState.InputActionTag;
+
+            inputActionAssetReferences->RemoveInputActionAddedListener(
+                inputActionTag,
+                EGameplayTagMatchType::Explicit,
+                bindingState.InputActionAddedListenerHandle);
+
+            inputActionAssetReferences->RemoveInputActionRemovedListener(
+                inputActionTag,
+                EGameplayTagMatchType::Explicit,
+                bindingState.InputActionRemovedListenerHandle);
+        }
+
+        bindingState.InputActionAddedListenerHandle.Reset();
+        bindingState.InputActionRemovedListenerHandle.Reset();
+    }
+
+    bIsListeningForInputActionChanges = false;
+}
+
+void UISActorComponent_PawnExtension::OnBindingInputActionAdded(const FGameplayTag& inTag, const UInputAction& inInputAction, const int32 inBindingIndex)
+{
+    if (!InputActionBindingStates.IsValidIndex(inBindingIndex))
+    {
+        return;
+    }
+
+    InputActionBindingStates[inBindingIndex].ResolvedInputAction = &inInputAction;
+
+    if (UEnhancedInputComponent* enhancedInputComponent = BoundEnhancedInputComponent.Get())
+    {
+        TryBindInputAction(inBindingIndex, *enhancedInputComponent);
+    }
+}
+
+void UISActorComponent_PawnExtension::OnBindingInputActionRemoved(const FGameplayTag& inTag, const UInputAction& inInputAction, const int32 inBindingIndex)
+{
+    if (!InputActionBindingStates.IsValidIndex(inBindingIndex))
+    {
+        return;
+    }
+
+    RemoveInputActionBinding(inBindingIndex);
+    InputActionBindingStates[inBindingIndex].ResolvedInputAction = nullptr;
 }
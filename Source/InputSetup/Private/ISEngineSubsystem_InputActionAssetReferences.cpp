@@ -3,6 +3,8 @@
 #include "ISEngineSubsystem_InputActionAssetReferences.h"
 
 #include "InputAction.h"
+#include "InputTriggers.h"
+#include "InputModifiers.h"
 #if WITH_EDITOR
 #include "ISettingsModule.h"
 #endif // #if WITH_EDITOR
@@ -12,13 +14,115 @@
 #include "Interfaces/IPluginManager.h"
 #include "GCUtils_AssetStreaming.h"
 #include "GCUtils_AssetStreaming.inl"
-#include "GCUtils_Set.h"
 #include "GCUtils_Log.h"
 #include "GCUtils_String.h"
+#include "GenericPlatform/GenericPlatformChunkInstall.h"
+#include "Algo/Reverse.h"
+#include "ISStats.h"
 
 DEFINE_LOG_CATEGORY_STATIC(LogISEngineSubsystem_InputActionAssetReferences, Log, All);
 
+namespace
+{
+    /**
+     * @brief Whether two objects are of the same class and all of their non-transient properties are identical.
+     */
+    bool AreObjectsStructurallyIdentical(const UObject& inA, const UObject& inB)
+    {
+        if (inA.GetClass() != inB.GetClass())
+        {
+            return false;
+        }
+
+        for (TFieldIterator<FProperty> propertyIterator(inA.GetClass()); propertyIterator; ++propertyIterator)
+        {
+            if (propertyIterator->HasAnyPropertyFlags(CPF_Transient))
+            {
+                continue;
+            }
+
+            for (int32 arrayIndex = 0; arrayIndex < propertyIterator->ArrayDim; ++arrayIndex)
+            {
+                if (!propertyIterator->Identical_InContainer(&inA, &inB, arrayIndex))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+}
+
+FDelegateHandle FISReferencedInputActionListenerTable::Add(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate)
+{
+    TMap<FGameplayTag, FISReferencedInputActionNativeDelegate>& listeners =
+        inMatchType == EGameplayTagMatchType::Explicit ? ExplicitTagListeners : ParentTagListeners;
+
+    return listeners.FindOrAdd(inTag).Add(MoveTemp(inDelegate));
+}
+
+bool FISReferencedInputActionListenerTable::Remove(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    const FDelegateHandle& inDelegateHandle)
+{
+    TMap<FGameplayTag, FISReferencedInputActionNativeDelegate>& listeners =
+        inMatchType == EGameplayTagMatchType::Explicit ? ExplicitTagListeners : ParentTagListeners;
+
+    FISReferencedInputActionNativeDelegate* foundDelegate = listeners.Find(inTag);
+    if (!foundDelegate)
+    {
+        return false;
+    }
+
+    const bool didRemove = foundDelegate->Remove(inDelegateHandle);
+    if (!foundDelegate->IsBound())
+    {
+        // Keep the table only holding tags that are actually listened to.
+        listeners.Remove(inTag);
+    }
+
+    return didRemove;
+}
+
+void FISReferencedInputActionListenerTable::Broadcast(const FGameplayTag& inTag, const UInputAction& inInputAction) const
+{
+    if (IsEmpty())
+    {
+        return;
+    }
+
+    // Broadcast copies of the delegates since listeners are allowed to add or remove listeners while being
+    // called, which can reallocate or remove the table's entries.
+
+    if (const FISReferencedInputActionNativeDelegate* foundDelegate = ExplicitTagListeners.Find(inTag))
+    {
+        const FISReferencedInputActionNativeDelegate delegateCopy = *foundDelegate;
+        delegateCopy.Broadcast(inTag, inInputAction);
+    }
+
+    if (ParentTagListeners.IsEmpty())
+    {
+        return;
+    }
+
+    for (FGameplayTag tag = inTag; tag.IsValid(); tag = tag.RequestDirectParent())
+    {
+        if (const FISReferencedInputActionNativeDelegate* foundDelegate = ParentTagListeners.Find(tag))
+        {
+            const FISReferencedInputActionNativeDelegate delegateCopy = *foundDelegate;
+            delegateCopy.Broadcast(inTag, inInputAction);
+        }
+    }
+}
+
 UISEngineSubsystem_InputActionAssetReferences::UISEngineSubsystem_InputActionAssetReferences()
+    : bShouldInternInputActionSubobjects(false)
+    , RegistrationFrameBudgetMilliseconds(0.f)
 {
 }
 
@@ -49,6 +153,22 @@ void UISEngineSubsystem_InputActionAssetReferences::Initialize(FSubsystemCollect
 
 void UISEngineSubsystem_InputActionAssetReferences::Deinitialize()
 {
+    if (PendingInputActionRegistrationsTickerHandle.IsValid())
+    {
+        FTSTicker::GetCoreTicker().RemoveTicker(PendingInputActionRegistrationsTickerHandle);
+        PendingInputActionRegistrationsTickerHandle.Reset();
+    }
+
+    if (ChunkInstallDelegateHandle.IsValid())
+    {
+        if (IPlatformChunkInstall* platformChunkInstall = FPlatformMisc::GetPlatformChunkInstall())
+        {
+            platformChunkInstall->RemoveChunkInstallDelegate(ChunkInstallDelegateHandle);
+        }
+
+        ChunkInstallDelegateHandle.Reset();
+    }
+
 #if WITH_EDITOR
     ISettingsModule& settingsModule = FModuleManager::GetModuleChecked<ISettingsModule>(TEXT("Settings"));
     settingsModule.UnregisterSettings(
@@ -82,16 +202,112 @@ FSoftObjectPath UISEngineSubsystem_InputActionAssetReferences::GetAssetReference
         );
 }
 
+FPrimaryAssetId UISEngineSubsystem_InputActionAssetReferences::GetAssetReferenceDataAssetPrimaryAssetIdForPlugin(
+    const TSharedRef<const IPlugin>& inPlugin)
+{
+    return FPrimaryAssetId(
+        UISPrimaryDataAsset_InputActionAssetReferences::PrimaryAssetType,
+        FName(WriteToString<64>(TEXT("IAAR_"), inPlugin->GetName()))
+        );
+}
+
 const UInputAction* UISEngineSubsystem_InputActionAssetReferences::GetInputAction(const FGameplayTag& inTag) const
 {
-    const TObjectPtr<const UInputAction>* foundInputAction = ReferencedInputActions.Find(inTag);
-    if (!foundInputAction)
+    const UInputAction* inputAction = FindInputAction(inTag);
+    FISStats::Get().RecordGetInputAction(inputAction != nullptr);
+    return inputAction;
+}
+
+TMap<FGameplayTag, TObjectPtr<const UInputAction>> UISEngineSubsystem_InputActionAssetReferences::GetAllInputActions() const
+{
+    TMap<FGameplayTag, TObjectPtr<const UInputAction>> inputActions;
+    inputActions.Reserve(ReferencedInputActions.Num());
+
+    for (int32 index = 0; index < ReferencedInputActions.Num(); ++index)
+    {
+        inputActions.Emplace(ReferencedInputActionTags[index], ReferencedInputActions[index]);
+    }
+
+    return inputActions;
+}
+
+const UInputAction* UISEngineSubsystem_InputActionAssetReferences::FindInputAction(const FGameplayTag& inTag) const
+{
+    const int32* foundIndex = ReferencedInputActionIndices.Find(inTag);
+    if (!foundIndex)
     {
         return nullptr;
     }
 
-    check(*foundInputAction);
-    return *foundInputAction;
+    const UInputAction* inputAction = ReferencedInputActions[*foundIndex];
+    check(inputAction);
+    return inputAction;
+}
+
+void UISEngineSubsystem_InputActionAssetReferences::UpdateRegistryStats() const
+{
+    SET_DWORD_STAT(STAT_ISRegisteredInputActions, ReferencedInputActions.Num());
+    SET_DWORD_STAT(STAT_ISPendingRegistrations, PendingInputActionRegistrationTags.Num());
+    SET_DWORD_STAT(STAT_ISPendingPluginChunks, DeferredPluginChunkIds.Num());
+
+    TRACE_COUNTER_SET(InputSetup_RegisteredInputActions, ReferencedInputActions.Num());
+    TRACE_COUNTER_SET(InputSetup_PendingRegistrations, PendingInputActionRegistrationTags.Num());
+    TRACE_COUNTER_SET(InputSetup_PendingPluginChunks, DeferredPluginChunkIds.Num());
+}
+
+FDelegateHandle UISEngineSubsystem_InputActionAssetReferences::AddInputActionAddedListener(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate,
+    const bool inShouldCallForExisting)
+{
+    if (inShouldCallForExisting)
+    {
+        if (inMatchType == EGameplayTagMatchType::Explicit)
+        {
+            if (const UInputAction* foundInputAction = FindInputAction(inTag))
+            {
+                inDelegate.ExecuteIfBound(inTag, *foundInputAction);
+            }
+        }
+        else
+        {
+            for (int32 index = 0; index < ReferencedInputActionTags.Num(); ++index)
+            {
+                if (ReferencedInputActionTags[index].MatchesTag(inTag))
+                {
+                    check(ReferencedInputActions[index]);
+                    inDelegate.ExecuteIfBound(ReferencedInputActionTags[index], *ReferencedInputActions[index]);
+                }
+            }
+        }
+    }
+
+    return InputActionAddedListeners.Add(inTag, inMatchType, MoveTemp(inDelegate));
+}
+
+FDelegateHandle UISEngineSubsystem_InputActionAssetReferences::AddInputActionRemovedListener(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate)
+{
+    return InputActionRemovedListeners.Add(inTag, inMatchType, MoveTemp(inDelegate));
+}
+
+bool UISEngineSubsystem_InputActionAssetReferences::RemoveInputActionAddedListener(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    const FDelegateHandle& inDelegateHandle)
+{
+    return InputActionAddedListeners.Remove(inTag, inMatchType, inDelegateHandle);
+}
+
+bool UISEngineSubsystem_InputActionAssetReferences::RemoveInputActionRemovedListener(
+    const FGameplayTag& inTag,
+    const EGameplayTagMatchType inMatchType,
+    const FDelegateHandle& inDelegateHandle)
+{
+    return InputActionRemovedListeners.Remove(inTag, inMatchType, inDelegateHandle);
 }
 
 bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(const FGameplayTag& inTag, const UInputAction* inAsset)
@@ -119,6 +335,7 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(
 bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(const FGameplayTag& inTag, const UInputAction& inAsset)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -132,7 +349,7 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(
             TEXT("Referenced asset: '") << GCUtils::String::GetUObjectPathName(inAsset) << TEXT("'.")
         );
 
-    if (const UInputAction* foundInputAction = GetInputAction(inTag))
+    if (const UInputAction* foundInputAction = FindInputAction(inTag))
     {
         GC_LOG_STR_UOBJECT(
             this,
@@ -151,7 +368,7 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(
         return false;
     }
 
-    ensure(ReferencedInputActions.Contains(inTag) == false);
+    ensure(ReferencedInputActionIndices.Contains(inTag) == false);
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -165,8 +382,19 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedInputAction(
             TEXT("Referenced asset: '") << GCUtils::String::GetUObjectPathName(inAsset) << TEXT("'.")
         );
 
-    ReferencedInputActions.Emplace(inTag, &inAsset);
+    if (bShouldInternInputActionSubobjects && !GIsEditor)
+    {
+        // Input actions are immutable at runtime, so it's safe to swap out their subobjects. Instances used
+        // by players are duplicated from these per action instance, so sharing them holds no state.
+        InternInputActionSubobjects(const_cast<UInputAction&>(inAsset));
+    }
+
+    const int32 newIndex = ReferencedInputActions.Emplace(&inAsset);
+    ReferencedInputActionTags.Emplace(inTag);
+    ReferencedInputActionIndices.Emplace(inTag, newIndex);
+    UpdateRegistryStats();
     OnInputActionAddedDelegate.Broadcast(inTag, inAsset);
+    InputActionAddedListeners.Broadcast(inTag, inAsset);
     return true;
 }
 
@@ -184,8 +412,8 @@ const UInputAction* UISEngineSubsystem_InputActionAssetReferences::TryRemoveRefe
             TEXT("Gameplay tag: '") << inTag.GetTagName() << TEXT("'.")
         );
 
-    const TObjectPtr<const UInputAction>* foundInputAction = ReferencedInputActions.Find(inTag);
-    if (!foundInputAction)
+    const int32* foundIndex = ReferencedInputActionIndices.Find(inTag);
+    if (!foundIndex)
     {
         GC_LOG_STR_UOBJECT(
             this,
@@ -197,8 +425,9 @@ const UInputAction* UISEngineSubsystem_InputActionAssetReferences::TryRemoveRefe
         return nullptr;
     }
 
-    check(*foundInputAction);
-    const UInputAction& inputAction = **foundInputAction;
+    const int32 index = *foundIndex;
+    check(ReferencedInputActions[index]);
+    const UInputAction& inputAction = *ReferencedInputActions[index];
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -212,10 +441,22 @@ const UInputAction* UISEngineSubsystem_InputActionAssetReferences::TryRemoveRefe
             TEXT("Referenced asset: '") << GCUtils::String::GetUObjectPathName(inputAction) << TEXT("'.")
         );
 
-    const int32 numRemoved = ReferencedInputActions.Remove(inTag);
-    ensure(numRemoved == 1);
+    ReleaseInternedInputActionSubobjects(inputAction);
+
+    ReferencedInputActionIndices.Remove(inTag);
+    ReferencedInputActions.RemoveAtSwap(index, 1, EAllowShrinking::No);
+    ReferencedInputActionTags.RemoveAtSwap(index, 1, EAllowShrinking::No);
+
+    // Point the tag of the element swapped into the removed slot at its new index.
+    if (ReferencedInputActionTags.IsValidIndex(index))
+    {
+        ReferencedInputActionIndices.FindChecked(ReferencedInputActionTags[index]) = index;
+    }
+
+    UpdateRegistryStats();
 
     OnInputActionRemovedDelegate.Broadcast(inTag, inputAction);
+    InputActionRemovedListeners.Broadcast(inTag, inputAction);
 
     return &inputAction;
 }
@@ -223,7 +464,8 @@ const UInputAction* UISEngineSubsystem_InputActionAssetReferences::TryRemoveRefe
 bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAsset(
     const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset)
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAsset);
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAsset, InputSetupChannel);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -233,7 +475,7 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAs
             << TEXT("Trying to add asset references data asset'") << GCUtils::String::GetUObjectPathName(inDataAsset) << TEXT("'.")
         );
 
-    if (AssetReferencesDataAssetSet.Contains(&inDataAsset))
+    if (AssetReferencesDataAssets.Contains(&inDataAsset))
     {
         GC_LOG_STR_UOBJECT(
             this,
@@ -249,7 +491,24 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAs
     // Make sure the data asset doesn't contain any already-added referenced assets.
     for (const TPair<FGameplayTag, TObjectPtr<UInputAction>>& tagToInputActionPair : inDataAsset.InputActionReferences)
     {
-        const UInputAction* foundInputAction = GetInputAction(tagToInputActionPair.Key);
+        if (IsInputActionRegistrationPending(tagToInputActionPair.Key))
+        {
+            GC_LOG_STR_UOBJECT(
+                this,
+                LogISEngineSubsystem_InputActionAssetReferences,
+                Error,
+                GCUtils::Materialize(TStringBuilder<512>())
+                    << TEXT("Caller tried adding a asset references data asset which contains a gameplay tag that's already pending registration.")
+                    TEXT(" ")
+                    TEXT("Asset referennces data asset: '") << GCUtils::String::GetUObjectPathName(inDataAsset) << TEXT("'.")
+                    TEXT(" ")
+                    TEXT("Culprit tag: '") << tagToInputActionPair.Key.GetTagName() << TEXT("'.")
+                );
+            ensure(false);
+            return false;
+        }
+
+        const UInputAction* foundInputAction = FindInputAction(tagToInputActionPair.Key);
         if (foundInputAction)
         {
             GC_LOG_STR_UOBJECT(
@@ -274,7 +533,13 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryAddReferencedAssetsDataAs
 
     // Add the data asset and all of its asset references.
 
-    AssetReferencesDataAssetSet.Emplace(&inDataAsset);
+    AssetReferencesDataAssets.Emplace(&inDataAsset);
+
+    if (RegistrationFrameBudgetMilliseconds > 0.f)
+    {
+        EnqueuePendingInputActionRegistrations(inDataAsset);
+        return true;
+    }
 
     for (const TPair<FGameplayTag, TObjectPtr<UInputAction>>& tagToInputActionPair: inDataAsset.InputActionReferences)
     {
@@ -310,7 +575,7 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryRemoveReferencedAssetsDat
             << TEXT("Trying to remove asset refereness data asset '") << GCUtils::String::GetUObjectPathName(inDataAsset) << TEXT("'.")
         );
 
-    const int32 numRemoved = AssetReferencesDataAssetSet.Remove(&inDataAsset);
+    const int32 numRemoved = AssetReferencesDataAssets.RemoveSingleSwap(&inDataAsset, EAllowShrinking::No);
     if (numRemoved <= 0)
     {
         // Nothing to remove.
@@ -319,8 +584,17 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryRemoveReferencedAssetsDat
 
     ensure(numRemoved == 1);
 
+    const TSet<FGameplayTag> droppedPendingTags = RemovePendingInputActionRegistrations(inDataAsset);
+    PendingPluginRegistrations.Remove(&inDataAsset);
+
     for (const TPair<FGameplayTag, TObjectPtr<UInputAction>>& tagToInputActionPair : inDataAsset.InputActionReferences)
     {
+        if (droppedPendingTags.Contains(tagToInputActionPair.Key))
+        {
+            // Was still pending registration.
+            continue;
+        }
+
         GC_LOG_STR_UOBJECT(
             this,
             LogISEngineSubsystem_InputActionAssetReferences,
@@ -338,10 +612,295 @@ bool UISEngineSubsystem_InputActionAssetReferences::TryRemoveReferencedAssetsDat
     return true;
 }
 
+void UISEngineSubsystem_InputActionAssetReferences::EnqueuePendingInputActionRegistrations(
+    const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::EnqueuePendingInputActionRegistrations);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
+
+    TArray<FISPendingInputActionRegistration> newPriorityRegistrations;
+    TArray<FISPendingInputActionRegistration> newRegistrations;
+    newRegistrations.Reserve(inDataAsset.InputActionReferences.Num());
+
+    for (const TPair<FGameplayTag, TObjectPtr<UInputAction>>& tagToInputActionPair : inDataAsset.InputActionReferences)
+    {
+        FISPendingInputActionRegistration registration;
+        registration.Tag = tagToInputActionPair.Key;
+        registration.InputAction = tagToInputActionPair.Value;
+        registration.DataAsset = &inDataAsset;
+
+        TArray<FISPendingInputActionRegistration>& registrations =
+            tagToInputActionPair.Key.MatchesAny(PriorityRegistrationTags) ? newPriorityRegistrations : newRegistrations;
+
+        registrations.Emplace(MoveTemp(registration));
+        PendingInputActionRegistrationTags.Emplace(tagToInputActionPair.Key);
+    }
+
+    // Queues are stored in reverse, so new registrations go in the front to be added after the existing ones.
+    Algo::Reverse(newPriorityRegistrations);
+    Algo::Reverse(newRegistrations);
+    PendingPriorityInputActionRegistrations.Insert(MoveTemp(newPriorityRegistrations), 0);
+    PendingInputActionRegistrations.Insert(MoveTemp(newRegistrations), 0);
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISEngineSubsystem_InputActionAssetReferences,
+        Log,
+        GCUtils::Materialize(TStringBuilder<512>())
+            << TEXT("Queued ") << inDataAsset.InputActionReferences.Num() << TEXT(" input actions of data asset '") << GCUtils::String::GetUObjectPathName(inDataAsset) << TEXT("' for time-sliced registration.")
+            TEXT(" ")
+            TEXT("Total pending: ") << PendingInputActionRegistrationTags.Num() << TEXT(".")
+        );
+
+    UpdateRegistryStats();
+
+    if (!PendingInputActionRegistrationsTickerHandle.IsValid())
+    {
+        PendingInputActionRegistrationsTickerHandle = FTSTicker::GetCoreTicker().AddTicker(
+            FTickerDelegate::CreateUObject(this, &ThisClass::TickPendingInputActionRegistrations));
+    }
+}
+
+TSet<FGameplayTag> UISEngineSubsystem_InputActionAssetReferences::RemovePendingInputActionRegistrations(
+    const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset)
+{
+    TSet<FGameplayTag> droppedTags;
+
+    auto isFromDataAsset =
+        [this, &inDataAsset, &droppedTags](const FISPendingInputActionRegistration& inRegistration)
+        {
+            if (inRegistration.DataAsset != &inDataAsset)
+            {
+                return false;
+            }
+
+            PendingInputActionRegistrationTags.Remove(inRegistration.Tag);
+            droppedTags.Emplace(inRegistration.Tag);
+            return true;
+        };
+
+    PendingPriorityInputActionRegistrations.RemoveAll(isFromDataAsset);
+    PendingInputActionRegistrations.RemoveAll(isFromDataAsset);
+
+    UpdateRegistryStats();
+    return droppedTags;
+}
+
+bool UISEngineSubsystem_InputActionAssetReferences::PrioritizePendingInputActionRegistration(const FGameplayTag& inTag)
+{
+    if (!IsInputActionRegistrationPending(inTag))
+    {
+        return false;
+    }
+
+    const int32 foundIndex = PendingInputActionRegistrations.IndexOfByPredicate(
+        [&inTag](const FISPendingInputActionRegistration& inRegistration)
+        {
+            return inRegistration.Tag == inTag;
+        }
+        );
+
+    if (foundIndex != INDEX_NONE)
+    {
+        // The back of the priority queue is added next.
+        PendingPriorityInputActionRegistrations.Emplace(PendingInputActionRegistrations[foundIndex]);
+        PendingInputActionRegistrations.RemoveAt(foundIndex, 1, EAllowShrinking::No);
+    }
+
+    // Otherwise it's already a priority registration.
+    return true;
+}
+
+bool UISEngineSubsystem_InputActionAssetReferences::TickPendingInputActionRegistrations(float inDeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(UISEngineSubsystem_InputActionAssetReferences::TickPendingInputActionRegistrations, InputSetupChannel);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
+
+    const double endTime = FPlatformTime::Seconds() + RegistrationFrameBudgetMilliseconds / 1000.0;
+
+    // Always make progress, even if a single registration exceeds the budget.
+    bool isFirstRegistration = true;
+
+    while (isFirstRegistration || FPlatformTime::Seconds() < endTime)
+    {
+        TArray<FISPendingInputActionRegistration>& registrations =
+            !PendingPriorityInputActionRegistrations.IsEmpty() ? PendingPriorityInputActionRegistrations : PendingInputActionRegistrations;
+
+        if (registrations.IsEmpty())
+        {
+            break;
+        }
+
+        // Pop before adding since listeners of the add are allowed to modify the queues.
+        const FISPendingInputActionRegistration registration = registrations.Pop(EAllowShrinking::No);
+        PendingInputActionRegistrationTags.Remove(registration.Tag);
+        isFirstRegistration = false;
+
+        const bool didAdd = TryAddReferencedInputAction(registration.Tag, registration.InputAction);
+        ensure(didAdd);
+
+        FISPendingPluginRegistration* pendingPluginRegistration = PendingPluginRegistrations.Find(registration.DataAsset);
+        if (pendingPluginRegistration && --pendingPluginRegistration->NumPendingEntries <= 0)
+        {
+            FISStats::Get().RecordPluginRegistration(
+                pendingPluginRegistration->PluginName,
+                FPlatformTime::Seconds() - pendingPluginRegistration->StartTime,
+                pendingPluginRegistration->NumEntries);
+
+            PendingPluginRegistrations.Remove(registration.DataAsset);
+        }
+    }
+
+    if (PendingInputActionRegistrationTags.IsEmpty())
+    {
+        PendingPriorityInputActionRegistrations.Empty();
+        PendingInputActionRegistrations.Empty();
+        PendingInputActionRegistrationsTickerHandle.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+void UISEngineSubsystem_InputActionAssetReferences::InternInputActionSubobjects(UInputAction& inInputAction)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::InternInputActionSubobjects);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
+
+    const FISInputActionSubobjectInterningStats previousStats = InputActionSubobjectInterningStats;
+
+    for (TObjectPtr<UInputTrigger>& trigger : inInputAction.Triggers)
+    {
+        if (trigger)
+        {
+            trigger = CastChecked<UInputTrigger>(&FindOrAddInternedInputActionSubobject(*trigger));
+        }
+    }
+
+    for (TObjectPtr<UInputModifier>& modifier : inInputAction.Modifiers)
+    {
+        if (modifier)
+        {
+            modifier = CastChecked<UInputModifier>(&FindOrAddInternedInputActionSubobject(*modifier));
+        }
+    }
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISEngineSubsystem_InputActionAssetReferences,
+        Verbose,
+        GCUtils::Materialize(TStringBuilder<512>())
+            << TEXT("Interned subobjects of input action '") << GCUtils::String::GetUObjectPathName(inInputAction) << TEXT("'.")
+            TEXT(" ")
+            TEXT("Objects saved: ") << (InputActionSubobjectInterningStats.NumObjectsSaved - previousStats.NumObjectsSaved) << TEXT(".")
+            TEXT(" ")
+            TEXT("Bytes saved: ") << (InputActionSubobjectInterningStats.NumBytesSaved - previousStats.NumBytesSaved) << TEXT(".")
+            TEXT(" ")
+            TEXT("Total objects saved: ") << InputActionSubobjectInterningStats.NumObjectsSaved << TEXT(".")
+            TEXT(" ")
+            TEXT("Total bytes saved: ") << InputActionSubobjectInterningStats.NumBytesSaved << TEXT(".")
+        );
+}
+
+UObject& UISEngineSubsystem_InputActionAssetReferences::FindOrAddInternedInputActionSubobject(UObject& inSubobject)
+{
+    const UClass* subobjectClass = inSubobject.GetClass();
+    const int64 subobjectSize = subobjectClass->GetStructureSize();
+
+    TArray<UObject*>& internedSubobjectsOfClass = InternedInputActionSubobjectsByClass.FindOrAdd(subobjectClass);
+
+    for (UObject* internedSubobject : internedSubobjectsOfClass)
+    {
+        check(internedSubobject);
+
+        // Either already interned (e.g. the input action is being added again without having been reloaded) or a
+        // duplicate of it. Every use past the first is saved, so that saved always equals the sum of (uses - 1).
+        if (internedSubobject == &inSubobject || AreObjectsStructurallyIdentical(*internedSubobject, inSubobject))
+        {
+            ++InputActionSubobjectInterningStats.NumObjectsSaved;
+            InputActionSubobjectInterningStats.NumBytesSaved += subobjectSize;
+            ++InternedInputActionSubobjectUseCounts.FindChecked(internedSubobject);
+            return *internedSubobject;
+        }
+    }
+
+    // Make our own copy to share rather than sharing the original, since the original would keep its input action
+    // (and therefore its plugin's content) alive for as long as we hold it.
+    UObject* newInternedSubobject = DuplicateObject<UObject>(&inSubobject, this);
+    check(newInternedSubobject);
+    newInternedSubobject->SetFlags(RF_Transient);
+
+    InternedInputActionSubobjects.Emplace(newInternedSubobject);
+    internedSubobjectsOfClass.Emplace(newInternedSubobject);
+    InternedInputActionSubobjectUseCounts.Emplace(newInternedSubobject, 1);
+    return *newInternedSubobject;
+}
+
+void UISEngineSubsystem_InputActionAssetReferences::ReleaseInternedInputActionSubobjects(const UInputAction& inInputAction)
+{
+    if (InternedInputActionSubobjects.IsEmpty())
+    {
+        return;
+    }
+
+    for (const TObjectPtr<UInputTrigger>& trigger : inInputAction.Triggers)
+    {
+        if (trigger)
+        {
+            ReleaseInternedInputActionSubobject(*trigger);
+        }
+    }
+
+    for (const TObjectPtr<UInputModifier>& modifier : inInputAction.Modifiers)
+    {
+        if (modifier)
+        {
+            ReleaseInternedInputActionSubobject(*modifier);
+        }
+    }
+}
+
+void UISEngineSubsystem_InputActionAssetReferences::ReleaseInternedInputActionSubobject(const UObject& inSubobject)
+{
+    int32* foundUseCount = InternedInputActionSubobjectUseCounts.Find(&inSubobject);
+    if (!foundUseCount)
+    {
+        // Not one of ours.
+        return;
+    }
+
+    --(*foundUseCount);
+    if (*foundUseCount > 0)
+    {
+        // Still shared, so one less object is saved by it.
+        --InputActionSubobjectInterningStats.NumObjectsSaved;
+        InputActionSubobjectInterningStats.NumBytesSaved -= inSubobject.GetClass()->GetStructureSize();
+        return;
+    }
+
+    InternedInputActionSubobjectUseCounts.Remove(&inSubobject);
+
+    if (TArray<UObject*>* foundInternedSubobjectsOfClass = InternedInputActionSubobjectsByClass.Find(inSubobject.GetClass()))
+    {
+        foundInternedSubobjectsOfClass->RemoveSingleSwap(const_cast<UObject*>(&inSubobject), EAllowShrinking::No);
+        if (foundInternedSubobjectsOfClass->IsEmpty())
+        {
+            InternedInputActionSubobjectsByClass.Remove(inSubobject.GetClass());
+        }
+    }
+
+    // The removed input action may still point at it, which keeps it alive until that input action is unloaded.
+    InternedInputActionSubobjects.RemoveSingleSwap(const_cast<UObject*>(&inSubobject), EAllowShrinking::No);
+}
+
 void UISEngineSubsystem_InputActionAssetReferences::OnAssetManagerCreated()
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::OnAssetManagerCreated);
 
+#if WITH_EDITOR
+    ApplyPluginContentChunkRules(UAssetManager::Get());
+#endif // #if WITH_EDITOR
+
     // Load the game project's configged references and add them.
     AddGameProjectAssetReferences(UAssetManager::Get());
 
@@ -355,6 +914,7 @@ void UISEngineSubsystem_InputActionAssetReferences::OnAssetManagerCreated()
 void UISEngineSubsystem_InputActionAssetReferences::AddGameProjectAssetReferences(UAssetManager& inAssetManager)
 {
     TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::AddGameProjectAssetReferences);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
 
     TSharedPtr<FStreamableHandle> streamableHandle;
 
@@ -428,9 +988,63 @@ void UISEngineSubsystem_InputActionAssetReferences::AddGameProjectAssetReference
         );
 }
 
+#if WITH_EDITOR
+void UISEngineSubsystem_InputActionAssetReferences::ApplyPluginContentChunkRules(UAssetManager& inAssetManager) const
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::ApplyPluginContentChunkRules);
+
+    for (const TPair<FString, int32>& pluginNameToChunkIdPair : PluginContentChunkIds)
+    {
+        TSharedPtr<IPlugin> plugin = IPluginManager::Get().FindPlugin(pluginNameToChunkIdPair.Key);
+        if (!plugin || !plugin->CanContainContent())
+        {
+            GC_LOG_STR_UOBJECT(
+                this,
+                LogISEngineSubsystem_InputActionAssetReferences,
+                Warning,
+                GCUtils::Materialize(TStringBuilder<512>())
+                    << TEXT("Chunk configured for plugin '") << pluginNameToChunkIdPair.Key << TEXT("' but no such plugin with content was found.")
+                );
+            continue;
+        }
+
+        const TSharedRef<const IPlugin> pluginRef = plugin.ToSharedRef();
+
+        // The asset manager needs to know about the data asset for its rules to be used when cooking.
+        inAssetManager.ScanPathForPrimaryAssets(
+            UISPrimaryDataAsset_InputActionAssetReferences::PrimaryAssetType,
+            WriteToString<256>(pluginRef->GetMountedAssetPath(), TEXT("Input")).ToString(),
+            UISPrimaryDataAsset_InputActionAssetReferences::StaticClass(),
+            false
+            );
+
+        // The referenced input actions are managed by the data asset, so they follow it into the chunk.
+        FPrimaryAssetRules primaryAssetRules;
+        primaryAssetRules.ChunkId = pluginNameToChunkIdPair.Value;
+
+        inAssetManager.SetPrimaryAssetRules(
+            GetAssetReferenceDataAssetPrimaryAssetIdForPlugin(pluginRef),
+            primaryAssetRules
+            );
+
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISEngineSubsystem_InputActionAssetReferences,
+            Log,
+            GCUtils::Materialize(TStringBuilder<512>())
+                << TEXT("Assigned asset references data asset of plugin '") << pluginNameToChunkIdPair.Key << TEXT("' to chunk ") << pluginNameToChunkIdPair.Value << TEXT(".")
+            );
+    }
+}
+#endif // #if WITH_EDITOR
+
 void UISEngineSubsystem_InputActionAssetReferences::OnPluginAddContent(TSharedRef<IPlugin>&& inPlugin)
 {
-    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::OnPluginAddContent);
+    TRACE_CPUPROFILER_EVENT_SCOPE_ON_CHANNEL(UISEngineSubsystem_InputActionAssetReferences::OnPluginAddContent, InputSetupChannel);
+    LLM_SCOPE_BYTAG(InputSetup_Registry);
+    SCOPE_CYCLE_COUNTER(STAT_ISPluginRegistration);
+
+    double startTime = FPlatformTime::Seconds();
 
     GC_LOG_STR_UOBJECT(
         this,
@@ -440,6 +1054,15 @@ void UISEngineSubsystem_InputActionAssetReferences::OnPluginAddContent(TSharedRe
             << TEXT("Plugin '") << inPlugin->GetName() << TEXT("' content added. Loading and adding asset references data asset, if any.")
         );
 
+    if (TryDeferPluginAddContentUntilChunkInstalled(inPlugin))
+    {
+        DeferredPluginStartTimes.Emplace(inPlugin->GetName(), startTime);
+        return;
+    }
+
+    // Time deferred plugins from when their content was first added.
+    DeferredPluginStartTimes.RemoveAndCopyValue(inPlugin->GetName(), startTime);
+
     // No need to have the streamable handle hold our loaded assets in memory as we will already store strong
     // references to them ourselves.
     constexpr bool shouldManageActiveHandle = false;
@@ -468,7 +1091,24 @@ void UISEngineSubsystem_InputActionAssetReferences::OnPluginAddContent(TSharedRe
         return;
     }
 
-    TryAddReferencedAssetsDataAsset(*loadedAssetReferenceDataAsset);
+    const bool didAdd = TryAddReferencedAssetsDataAsset(*loadedAssetReferenceDataAsset);
+    const int32 numEntries = loadedAssetReferenceDataAsset->InputActionReferences.Num();
+
+    if (didAdd && RegistrationFrameBudgetMilliseconds > 0.f && numEntries > 0)
+    {
+        // Reported by `TickPendingInputActionRegistrations()` once its last input action is added.
+        FISPendingPluginRegistration& pendingPluginRegistration = PendingPluginRegistrations.Emplace(loadedAssetReferenceDataAsset);
+        pendingPluginRegistration.PluginName = inPlugin->GetName();
+        pendingPluginRegistration.StartTime = startTime;
+        pendingPluginRegistration.NumEntries = numEntries;
+        pendingPluginRegistration.NumPendingEntries = numEntries;
+        return;
+    }
+
+    FISStats::Get().RecordPluginRegistration(
+        inPlugin->GetName(),
+        FPlatformTime::Seconds() - startTime,
+        numEntries);
 }
 
 void UISEngineSubsystem_InputActionAssetReferences::OnPluginRemoveContent(TSharedRef<IPlugin>&& inPlugin)
@@ -483,11 +1123,18 @@ void UISEngineSubsystem_InputActionAssetReferences::OnPluginRemoveContent(TShare
             << TEXT("Plugin '") << inPlugin->GetName() << TEXT("' content removed. Removing asset references data asset, if any.")
         );
 
+    if (DeferredPluginChunkIds.Remove(inPlugin->GetName()) > 0)
+    {
+        // Its content was never added.
+        DeferredPluginStartTimes.Remove(inPlugin->GetName());
+        UpdateRegistryStats();
+        return;
+    }
+
     FSoftObjectPath assetReferenceDataAssetPath = GetAssetReferenceDataAssetPathForPlugin(inPlugin);
 
     const TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>* foundAssetReferenceDataAsset =
-        GCUtils::Set::FindByPredicate<TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>>(
-            AssetReferencesDataAssetSet,
+        AssetReferencesDataAssets.FindByPredicate(
             [&assetReferenceDataAssetPath](const TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>& inDataAsset)
             {
                 return FSoftObjectPath(inDataAsset) == assetReferenceDataAssetPath;
@@ -509,3 +1156,89 @@ void UISEngineSubsystem_InputActionAssetReferences::OnPluginRemoveContent(TShare
     check(*foundAssetReferenceDataAsset);
     TryRemoveReferencedAssetsDataAsset(**foundAssetReferenceDataAsset);
 }
+
+bool UISEngineSubsystem_InputActionAssetReferences::TryDeferPluginAddContentUntilChunkInstalled(const TSharedRef<IPlugin>& inPlugin)
+{
+    const int32* foundChunkId = PluginContentChunkIds.Find(inPlugin->GetName());
+    if (!foundChunkId)
+    {
+        return false;
+    }
+
+    IPlatformChunkInstall* platformChunkInstall = FPlatformMisc::GetPlatformChunkInstall();
+    if (!platformChunkInstall || platformChunkInstall->GetPakchunkLocation(*foundChunkId) != EChunkLocation::NotAvailable)
+    {
+        return false;
+    }
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISEngineSubsystem_InputActionAssetReferences,
+        Log,
+        GCUtils::Materialize(TStringBuilder<512>())
+            << TEXT("Chunk ") << *foundChunkId << TEXT(" of plugin '") << inPlugin->GetName() << TEXT("' is not installed. Deferring adding its asset references until it is.")
+        );
+
+    DeferredPluginChunkIds.Emplace(inPlugin->GetName(), *foundChunkId);
+    UpdateRegistryStats();
+
+    if (!ChunkInstallDelegateHandle.IsValid())
+    {
+        ChunkInstallDelegateHandle = platformChunkInstall->AddChunkInstallDelegate(
+            FPlatformChunkInstallDelegate::CreateUObject(this, &ThisClass::OnChunkInstalled));
+    }
+
+    return true;
+}
+
+void UISEngineSubsystem_InputActionAssetReferences::OnChunkInstalled(uint32 inChunkId, bool inSuccess)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISEngineSubsystem_InputActionAssetReferences::OnChunkInstalled);
+
+    if (!inSuccess)
+    {
+        return;
+    }
+
+    TArray<FString, TInlineAllocator<4>> installedPluginNames;
+    for (const TPair<FString, int32>& pluginNameToChunkIdPair : DeferredPluginChunkIds)
+    {
+        if (pluginNameToChunkIdPair.Value == static_cast<int32>(inChunkId))
+        {
+            installedPluginNames.Emplace(pluginNameToChunkIdPair.Key);
+        }
+    }
+
+    for (const FString& pluginName : installedPluginNames)
+    {
+        DeferredPluginChunkIds.Remove(pluginName);
+        UpdateRegistryStats();
+
+        TSharedPtr<IPlugin> plugin = IPluginManager::Get().FindPlugin(pluginName);
+        if (!plugin)
+        {
+            DeferredPluginStartTimes.Remove(pluginName);
+            continue;
+        }
+
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISEngineSubsystem_InputActionAssetReferences,
+            Log,
+            GCUtils::Materialize(TStringBuilder<512>())
+                << TEXT("Chunk ") << inChunkId << TEXT(" of plugin '") << pluginName << TEXT("' installed. Adding its deferred asset references.")
+            );
+
+        OnPluginAddContent(plugin.ToSharedRef());
+    }
+
+    if (DeferredPluginChunkIds.IsEmpty())
+    {
+        if (IPlatformChunkInstall* platformChunkInstall = FPlatformMisc::GetPlatformChunkInstall())
+        {
+            platformChunkInstall->RemoveChunkInstallDelegate(ChunkInstallDelegateHandle);
+        }
+
+        ChunkInstallDelegateHandle.Reset();
+    }
+}
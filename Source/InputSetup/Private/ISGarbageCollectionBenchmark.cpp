@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ISGarbageCollectionBenchmark.h"
+
+#include "InputAction.h"
+#include "HAL/IConsoleManager.h"
+#include "UObject/GarbageCollection.h"
+#include "UObject/Package.h"
+#include "ISStats.h"
+
+#if IS_WITH_RUNTIME_STATS
+namespace
+{
+    /**
+     * @return Average milliseconds of a full garbage collection.
+     */
+    double TimeCollectGarbage(const int32 inNumRuns)
+    {
+        double totalSeconds = 0.0;
+        for (int32 run = 0; run < inNumRuns; ++run)
+        {
+            const double startTime = FPlatformTime::Seconds();
+            CollectGarbage(GARBAGE_OBJECT_FLAGS, true);
+            totalSeconds += FPlatformTime::Seconds() - startTime;
+        }
+
+        return totalSeconds * 1000.0 / inNumRuns;
+    }
+
+    void BenchmarkGarbageCollection(const TArray<FString>& inArgs, FOutputDevice& inOutputDevice)
+    {
+        const int32 numThousandActions = inArgs.IsValidIndex(0) ? FMath::Max(FCString::Atoi(*inArgs[0]), 1) : 10;
+        const int32 numRuns = inArgs.IsValidIndex(1) ? FMath::Max(FCString::Atoi(*inArgs[1]), 1) : 5;
+        const int32 numActions = numThousandActions * 1000;
+
+        UISGarbageCollectionBenchmarkReferences* references = NewObject<UISGarbageCollectionBenchmarkReferences>(GetTransientPackage());
+        references->AddToRoot();
+
+        const double baselineMilliseconds = TimeCollectGarbage(numRuns);
+
+        references->ArrayReferences.Reserve(numActions);
+        for (int32 index = 0; index < numActions; ++index)
+        {
+            references->ArrayReferences.Emplace(NewObject<UInputAction>(GetTransientPackage()));
+        }
+
+        const double arrayMilliseconds = TimeCollectGarbage(numRuns);
+
+        // Move the same input actions into the map so only it keeps them alive.
+        references->MapReferences.Reserve(numActions);
+        for (int32 index = 0; index < numActions; ++index)
+        {
+            references->MapReferences.Emplace(FName(TEXT("InputSetup.Benchmark"), index + 1), references->ArrayReferences[index]);
+        }
+
+        references->ArrayReferences.Empty();
+
+        const double mapMilliseconds = TimeCollectGarbage(numRuns);
+
+        references->MapReferences.Empty();
+        references->RemoveFromRoot();
+        CollectGarbage(GARBAGE_OBJECT_FLAGS, true);
+
+        inOutputDevice.Logf(TEXT("InputSetup GC benchmark: %d input actions, average of %d full collections."), numActions, numRuns);
+        inOutputDevice.Logf(TEXT("  Baseline:              %8.3f ms"), baselineMilliseconds);
+        inOutputDevice.Logf(TEXT("  Map (previous layout): %8.3f ms (+%.3f ms)"), mapMilliseconds, mapMilliseconds - baselineMilliseconds);
+        inOutputDevice.Logf(TEXT("  Array (current):       %8.3f ms (+%.3f ms)"), arrayMilliseconds, arrayMilliseconds - baselineMilliseconds);
+    }
+
+    FAutoConsoleCommandWithArgsAndOutputDevice BenchmarkGCConsoleCommand(
+        TEXT("InputSetup.BenchmarkGC"),
+        TEXT("Times full garbage collections with thousands of input actions referenced the way the registry used to (a map) and does now (an array). Usage: InputSetup.BenchmarkGC [NumThousandActions=10] [NumRuns=5]"),
+        FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&BenchmarkGarbageCollection)
+        );
+}
+#endif // #if IS_WITH_RUNTIME_STATS
@@ -0,0 +1,29 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/Object.h"
+
+#include "ISGarbageCollectionBenchmark.generated.h"
+
+class UInputAction;
+
+/**
+ * @brief Holds input action references for the `InputSetup.BenchmarkGC` console command, in the layout
+ *        `UISEngineSubsystem_InputActionAssetReferences` used before (a map) and the one it uses now (an array).
+ *        Gameplay tags can't be made up at runtime, so the registry itself can't be filled with thousands of input actions.
+ */
+UCLASS(Transient)
+class UISGarbageCollectionBenchmarkReferences : public UObject
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY()
+    TMap<FName, TObjectPtr<const UInputAction>> MapReferences;
+
+    UPROPERTY()
+    TArray<TObjectPtr<const UInputAction>> ArrayReferences;
+};
@@ -0,0 +1,225 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ISEngineSubsystem_InputActionAssetReferences.h"
+#include "ISPrimaryDataAsset_InputActionAssetReferences.h"
+#include "ActorComponents/ISActorComponent_PawnExtension.h"
+#include "InputAction.h"
+#include "InputMappingContext.h"
+#include "Engine/Engine.h"
+#include "HAL/IConsoleManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/ArchiveCountMem.h"
+#include "UObject/UObjectIterator.h"
+#include "ISStats.h"
+
+namespace
+{
+    struct FISMemoryReportRow
+    {
+    public:
+
+        const TCHAR* Category = TEXT("");
+        FString Name;
+        FString Owner;
+        int32 NumObjects = 0;
+        int64 NumBytes = 0;
+    };
+
+    /**
+     * @brief Approximate resident size of an object: its serialized memory plus any resource memory it reports.
+     */
+    int64 GetObjectResidentBytes(const UObject& inObject)
+    {
+        UObject& object = const_cast<UObject&>(inObject);
+
+        FArchiveCountMem countMem(&object);
+        return static_cast<int64>(countMem.GetMax()) + static_cast<int64>(object.GetResourceSizeBytes(EResourceSizeMode::Exclusive));
+    }
+
+    /**
+     * @brief Add the resident size of the object and its subobjects (e.g. instanced triggers and modifiers) to the row.
+     */
+    void AddObjectAndSubobjects(const UObject* inObject, FISMemoryReportRow& inOutRow)
+    {
+        if (!inObject)
+        {
+            return;
+        }
+
+        inOutRow.NumObjects += 1;
+        inOutRow.NumBytes += GetObjectResidentBytes(*inObject);
+
+        TArray<UObject*> subobjects;
+        GetObjectsWithOuter(inObject, subobjects, true);
+
+        for (const UObject* subobject : subobjects)
+        {
+            inOutRow.NumObjects += 1;
+            inOutRow.NumBytes += GetObjectResidentBytes(*subobject);
+        }
+    }
+
+    void GatherMemoryReportRows(TArray<FISMemoryReportRow>& outRows)
+    {
+        const UISEngineSubsystem_InputActionAssetReferences* inputActionAssetReferences =
+            GEngine ? GEngine->GetEngineSubsystem<UISEngineSubsystem_InputActionAssetReferences>() : nullptr;
+
+        if (inputActionAssetReferences)
+        {
+            // Per plugin data asset, including the input actions it contributes.
+            TMap<FGameplayTag, FString> tagToDataAssetNames;
+            for (const TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>& dataAsset : inputActionAssetReferences->GetAllAssetReferencesDataAssets())
+            {
+                if (!dataAsset)
+                {
+                    continue;
+                }
+
+                FISMemoryReportRow& row = outRows.AddDefaulted_GetRef();
+                row.Category = TEXT("DataAsset");
+                row.Name = dataAsset->GetPathName();
+                row.Owner = dataAsset->GetPackage()->GetName();
+
+                AddObjectAndSubobjects(dataAsset, row);
+
+                for (const TPair<FGameplayTag, TObjectPtr<UInputAction>>& tagToInputActionPair : dataAsset->InputActionReferences)
+                {
+                    AddObjectAndSubobjects(tagToInputActionPair.Value, row);
+                    tagToDataAssetNames.Emplace(tagToInputActionPair.Key, row.Name);
+                }
+            }
+
+            // Per tag.
+            const TConstArrayView<FGameplayTag> tags = inputActionAssetReferences->GetAllInputActionTags();
+            const TConstArrayView<TObjectPtr<const UInputAction>> inputActions = inputActionAssetReferences->GetAllInputActionsArray();
+
+            for (int32 index = 0; index < tags.Num(); ++index)
+            {
+                FISMemoryReportRow& row = outRows.AddDefaulted_GetRef();
+                row.Category = TEXT("InputActionTag");
+                row.Name = tags[index].ToString();
+
+                const FString* foundDataAssetName = tagToDataAssetNames.Find(tags[index]);
+                row.Owner = foundDataAssetName ? *foundDataAssetName : FString(TEXT("GameProject"));
+
+                AddObjectAndSubobjects(inputActions[index], row);
+            }
+        }
+
+        // Per pawn component, counting the mapping contexts it pins.
+        for (TObjectIterator<UISActorComponent_PawnExtension> componentIterator; componentIterator; ++componentIterator)
+        {
+            const UISActorComponent_PawnExtension* component = *componentIterator;
+            if (component->HasAnyFlags(RF_ClassDefaultObject | RF_ArchetypeObject))
+            {
+                continue;
+            }
+
+            FISMemoryReportRow& row = outRows.AddDefaulted_GetRef();
+            row.Category = TEXT("PawnExtension");
+            row.Name = component->GetPathName();
+            row.Owner = GetNameSafe(component->GetOwner());
+
+            for (const FISInputMappingContextAddArgs& inputMappingContextAddArgs : component->InputMappingContextsToAdd)
+            {
+                AddObjectAndSubobjects(inputMappingContextAddArgs.InputMappingContext, row);
+            }
+
+            for (const FISInputMappingContextTagRule& rule : component->InputMappingContextTagRules)
+            {
+                AddObjectAndSubobjects(rule.InputMappingContextAddArgs.InputMappingContext, row);
+            }
+        }
+    }
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+    /**
+     * @brief Add a row per InputSetup LLM tag with the memory currently tracked for it.
+     */
+    void GatherLowLevelMemTrackerRows(TArray<FISMemoryReportRow>& outRows)
+    {
+        if (!FLowLevelMemTracker::IsEnabled())
+        {
+            return;
+        }
+
+        // The tags' unique names, which `LLM_DEFINE_TAG()` makes from the identifier by turning underscores into slashes
+        // (e.g. "InputSetup/Registry").
+        const FName tagNames[] =
+        {
+            LLM_TAG_NAME(InputSetup),
+            LLM_TAG_NAME(InputSetup_Registry),
+            LLM_TAG_NAME(InputSetup_BotInput),
+            LLM_TAG_NAME(InputSetup_PawnExtension),
+        };
+
+        for (const FName& tagName : tagNames)
+        {
+            FISMemoryReportRow& row = outRows.AddDefaulted_GetRef();
+            row.Category = TEXT("LLMTag");
+            row.Name = tagName.ToString();
+            row.Owner = TEXT("LowLevelMemTracker");
+            row.NumBytes = FLowLevelMemTracker::Get().GetTagAmountForTracker(ELLMTracker::Default, tagName, ELLMTagSet::None);
+        }
+    }
+#endif // #if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+    void DumpMemoryReport(const TArray<FString>& inArgs, FOutputDevice& inOutputDevice)
+    {
+        TArray<FISMemoryReportRow> rows;
+        GatherMemoryReportRows(rows);
+
+#if ENABLE_LOW_LEVEL_MEM_TRACKER
+        GatherLowLevelMemTrackerRows(rows);
+#endif // #if ENABLE_LOW_LEVEL_MEM_TRACKER
+
+        TStringBuilder<4096> csv;
+        csv << TEXT("Category,Name,Owner,NumObjects,Bytes\n");
+
+        int64 totalBytes = 0;
+        for (const FISMemoryReportRow& row : rows)
+        {
+            inOutputDevice.Logf(TEXT("  %-16s %-64s %-48s %6d objects %10lld bytes"),
+                row.Category,
+                *row.Name,
+                *row.Owner,
+                row.NumObjects,
+                row.NumBytes);
+
+            csv << row.Category << TEXT(',')
+                << row.Name << TEXT(',')
+                << row.Owner << TEXT(',')
+                << row.NumObjects << TEXT(',')
+                << row.NumBytes << TEXT('\n');
+
+            // Data asset rows already include their input actions, so only tag rows add up to the registry's total. LLM
+            // rows measure allocations rather than objects, so they aren't part of it either.
+            if (FCString::Strcmp(row.Category, TEXT("DataAsset")) != 0 && FCString::Strcmp(row.Category, TEXT("LLMTag")) != 0)
+            {
+                totalBytes += row.NumBytes;
+            }
+        }
+
+        inOutputDevice.Logf(TEXT("InputSetup memory: %d rows, %lld bytes across input action tags and pawn extensions."), rows.Num(), totalBytes);
+
+        const FString csvPath = !inArgs.IsEmpty()
+            ? inArgs[0]
+            : FPaths::Combine(FPaths::ProfilingDir(), TEXT("InputSetup"), FString::Printf(TEXT("Memory-%s.csv"), *FDateTime::Now().ToString()));
+
+        if (FFileHelper::SaveStringToFile(csv.ToView(), *csvPath))
+        {
+            inOutputDevice.Logf(TEXT("InputSetup memory report written to '%s'."), *csvPath);
+        }
+        else
+        {
+            inOutputDevice.Logf(ELogVerbosity::Error, TEXT("Failed to write InputSetup memory report to '%s'."), *csvPath);
+        }
+    }
+
+    FAutoConsoleCommandWithArgsAndOutputDevice DumpMemoryConsoleCommand(
+        TEXT("InputSetup.DumpMemory"),
+        TEXT("Logs the resident size of InputSetup content per input action tag, per plugin data asset and per pawn extension component, along with the memory tracked per InputSetup LLM tag when LLM is enabled, and writes it as CSV. Usage: InputSetup.DumpMemory [CsvPath]"),
+        FConsoleCommandWithArgsAndOutputDeviceDelegate::CreateStatic(&DumpMemoryReport)
+        );
+}
@@ -1,3 +1,5 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ISPrimaryDataAsset_InputActionAssetReferences.h"
+
+const FPrimaryAssetType UISPrimaryDataAsset_InputActionAssetReferences::PrimaryAssetType = FPrimaryAssetType(TEXT("ISPrimaryDataAsset_InputActionAssetReferences"));
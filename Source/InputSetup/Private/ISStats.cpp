@@ -0,0 +1,168 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ISStats.h"
+
+#include "ISEngineSubsystem_InputActionAssetReferences.h"
+#include "ActorComponents/ISActorComponent_PawnExtension.h"
+#include "HAL/IConsoleManager.h"
+#include "Engine/Engine.h"
+#include "Misc/CoreDelegates.h"
+
+DEFINE_STAT(STAT_ISRegisteredInputActions);
+DEFINE_STAT(STAT_ISGetInputActionCalls);
+DEFINE_STAT(STAT_ISGetInputActionMisses);
+DEFINE_STAT(STAT_ISPendingRegistrations);
+DEFINE_STAT(STAT_ISPendingPluginChunks);
+DEFINE_STAT(STAT_ISRestartMappingContexts);
+DEFINE_STAT(STAT_ISPluginRegistration);
+DEFINE_STAT(STAT_ISOnOwnerPawnClientRestart);
+
+LLM_DEFINE_TAG(InputSetup);
+LLM_DEFINE_TAG(InputSetup_Registry, TEXT("Registry"), TEXT("InputSetup"));
+LLM_DEFINE_TAG(InputSetup_BotInput, TEXT("BotInput"), TEXT("InputSetup"));
+LLM_DEFINE_TAG(InputSetup_PawnExtension, TEXT("PawnExtension"), TEXT("InputSetup"));
+
+UE_TRACE_CHANNEL_DEFINE(InputSetupChannel);
+
+TRACE_DECLARE_INT_COUNTER(InputSetup_RegisteredInputActions, TEXT("InputSetup/RegisteredInputActions"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_PendingRegistrations, TEXT("InputSetup/PendingRegistrations"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_PendingPluginChunks, TEXT("InputSetup/PendingPluginChunks"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_GetInputActionCallsPerFrame, TEXT("InputSetup/GetInputActionCallsPerFrame"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_GetInputActionMissesPerFrame, TEXT("InputSetup/GetInputActionMissesPerFrame"));
+TRACE_DECLARE_FLOAT_COUNTER(InputSetup_GetInputActionMissRate, TEXT("InputSetup/GetInputActionMissRate"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_RestartMappingContexts, TEXT("InputSetup/RestartMappingContexts"));
+TRACE_DECLARE_INT_COUNTER(InputSetup_LastPluginRegistrationEntries, TEXT("InputSetup/LastPluginRegistrationEntries"));
+TRACE_DECLARE_FLOAT_COUNTER(InputSetup_LastPluginRegistrationMilliseconds, TEXT("InputSetup/LastPluginRegistrationMilliseconds"));
+
+namespace
+{
+    FAutoConsoleCommandWithOutputDevice DumpStatsConsoleCommand(
+        TEXT("InputSetup.DumpStats"),
+        TEXT("Logs InputSetup registry and input counters."),
+        FConsoleCommandWithOutputDeviceDelegate::CreateLambda(
+            [](FOutputDevice& inOutputDevice)
+            {
+                FISStats::Get().Dump(inOutputDevice);
+            }
+            )
+        );
+}
+
+FISStats& FISStats::Get()
+{
+    static FISStats stats;
+    return stats;
+}
+
+void FISStats::Initialize()
+{
+#if IS_WITH_RUNTIME_STATS
+    if (!EndFrameDelegateHandle.IsValid())
+    {
+        EndFrameDelegateHandle = FCoreDelegates::OnEndFrame.AddRaw(this, &FISStats::OnEndFrame);
+    }
+#endif // #if IS_WITH_RUNTIME_STATS
+}
+
+void FISStats::Deinitialize()
+{
+#if IS_WITH_RUNTIME_STATS
+    FCoreDelegates::OnEndFrame.Remove(EndFrameDelegateHandle);
+    EndFrameDelegateHandle.Reset();
+#endif // #if IS_WITH_RUNTIME_STATS
+}
+
+#if IS_WITH_RUNTIME_STATS
+void FISStats::OnEndFrame()
+{
+    LastFrameNumGetInputActionCalls = NumGetInputActionCallsThisFrame.exchange(0, std::memory_order_relaxed);
+    LastFrameNumGetInputActionMisses = NumGetInputActionMissesThisFrame.exchange(0, std::memory_order_relaxed);
+
+    TRACE_COUNTER_SET(InputSetup_GetInputActionCallsPerFrame, LastFrameNumGetInputActionCalls);
+    TRACE_COUNTER_SET(InputSetup_GetInputActionMissesPerFrame, LastFrameNumGetInputActionMisses);
+    TRACE_COUNTER_SET(InputSetup_GetInputActionMissRate,
+        LastFrameNumGetInputActionCalls > 0 ? static_cast<double>(LastFrameNumGetInputActionMisses) / LastFrameNumGetInputActionCalls : 0.0);
+}
+#endif // #if IS_WITH_RUNTIME_STATS
+
+void FISStats::RecordPluginRegistration(const FString& inPluginName, const double inSeconds, const int32 inNumEntries)
+{
+    TRACE_COUNTER_SET(InputSetup_LastPluginRegistrationEntries, inNumEntries);
+    TRACE_COUNTER_SET(InputSetup_LastPluginRegistrationMilliseconds, inSeconds * 1000.0);
+    TRACE_BOOKMARK(TEXT("InputSetup: plugin '%s' registered %d entries in %.3f ms"), *inPluginName, inNumEntries, inSeconds * 1000.0);
+
+#if IS_WITH_RUNTIME_STATS
+    FPluginRegistration& pluginRegistration = PluginRegistrations.FindOrAdd(inPluginName);
+    pluginRegistration.Seconds = inSeconds;
+    pluginRegistration.NumEntries = inNumEntries;
+#endif // #if IS_WITH_RUNTIME_STATS
+}
+
+void FISStats::RecordOwnerPawnClientRestart(const double inSeconds, const int32 inNumMappingContexts)
+{
+    SET_DWORD_STAT(STAT_ISRestartMappingContexts, inNumMappingContexts);
+    TRACE_COUNTER_SET(InputSetup_RestartMappingContexts, inNumMappingContexts);
+
+#if IS_WITH_RUNTIME_STATS
+    ++NumOwnerPawnClientRestarts;
+    TotalOwnerPawnClientRestartSeconds += inSeconds;
+    MaxOwnerPawnClientRestartSeconds = FMath::Max(MaxOwnerPawnClientRestartSeconds, inSeconds);
+    LastOwnerPawnClientRestartNumMappingContexts = inNumMappingContexts;
+#endif // #if IS_WITH_RUNTIME_STATS
+}
+
+void FISStats::Dump(FOutputDevice& inOutputDevice) const
+{
+    inOutputDevice.Logf(TEXT("InputSetup stats:"));
+
+    if (const UISEngineSubsystem_InputActionAssetReferences* inputActionAssetReferences =
+        GEngine ? GEngine->GetEngineSubsystem<UISEngineSubsystem_InputActionAssetReferences>() : nullptr)
+    {
+        inOutputDevice.Logf(TEXT("  Registered input actions: %d"), inputActionAssetReferences->GetAllInputActionTags().Num());
+        inOutputDevice.Logf(TEXT("  Pending registrations: %d"), inputActionAssetReferences->GetNumPendingInputActionRegistrations());
+        inOutputDevice.Logf(TEXT("  Pending plugin chunks: %d"), inputActionAssetReferences->GetNumDeferredPluginChunks());
+
+        const FISInputActionSubobjectInterningStats& interningStats = inputActionAssetReferences->GetInputActionSubobjectInterningStats();
+        inOutputDevice.Logf(TEXT("  Interned input action subobjects saved: %d objects, %lld bytes"),
+            interningStats.NumObjectsSaved,
+            interningStats.NumBytesSaved);
+    }
+
+#if IS_WITH_RUNTIME_STATS
+    const int64 numGetInputActionCalls = NumGetInputActionCalls.load(std::memory_order_relaxed);
+    const int64 numGetInputActionMisses = NumGetInputActionMisses.load(std::memory_order_relaxed);
+
+    inOutputDevice.Logf(TEXT("  GetInputAction calls: %lld, misses: %lld (%.2f%%)"),
+        numGetInputActionCalls,
+        numGetInputActionMisses,
+        numGetInputActionCalls > 0 ? 100.0 * numGetInputActionMisses / numGetInputActionCalls : 0.0);
+
+    inOutputDevice.Logf(TEXT("  GetInputAction last frame: %d calls, %d misses (%.2f%%)"),
+        LastFrameNumGetInputActionCalls,
+        LastFrameNumGetInputActionMisses,
+        LastFrameNumGetInputActionCalls > 0 ? 100.0 * LastFrameNumGetInputActionMisses / LastFrameNumGetInputActionCalls : 0.0);
+
+    inOutputDevice.Logf(TEXT("  Plugin registrations: %d"), PluginRegistrations.Num());
+    for (const TPair<FString, FPluginRegistration>& pluginNameToRegistrationPair : PluginRegistrations)
+    {
+        inOutputDevice.Logf(TEXT("    %s: %d entries in %.3f ms"),
+            *pluginNameToRegistrationPair.Key,
+            pluginNameToRegistrationPair.Value.NumEntries,
+            pluginNameToRegistrationPair.Value.Seconds * 1000.0);
+    }
+
+    inOutputDevice.Logf(TEXT("  OnOwnerPawnClientRestart: %d calls, average %.3f ms, max %.3f ms, last mapping context count %d"),
+        NumOwnerPawnClientRestarts,
+        NumOwnerPawnClientRestarts > 0 ? TotalOwnerPawnClientRestartSeconds * 1000.0 / NumOwnerPawnClientRestarts : 0.0,
+        MaxOwnerPawnClientRestartSeconds * 1000.0,
+        LastOwnerPawnClientRestartNumMappingContexts);
+#else
+    inOutputDevice.Logf(TEXT("  Runtime counters are compiled out (IS_WITH_RUNTIME_STATS)."));
+#endif // #if IS_WITH_RUNTIME_STATS
+
+    const FISPossessionPrewarmStats& possessionPrewarmStats = UISActorComponent_PawnExtension::GetPossessionPrewarmStats();
+    inOutputDevice.Logf(TEXT("  Possession prewarm: %d hits, %d misses, %d not prewarmed"),
+        possessionPrewarmStats.NumHits,
+        possessionPrewarmStats.NumMisses,
+        possessionPrewarmStats.NumNotPrewarmed);
+}
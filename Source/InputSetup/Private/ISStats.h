@@ -0,0 +1,148 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Stats/Stats.h"
+#include "Trace/Trace.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+#include "ProfilingDebugging/MiscTrace.h"
+#include "HAL/LowLevelMemTracker.h"
+
+#include <atomic>
+
+/**
+ * @brief Whether InputSetup gathers the runtime numbers reported by the "InputSetup.DumpStats" console command.
+ */
+#ifndef IS_WITH_RUNTIME_STATS
+#define IS_WITH_RUNTIME_STATS !UE_BUILD_SHIPPING
+#endif
+
+DECLARE_STATS_GROUP(TEXT("InputSetup"), STATGROUP_InputSetup, STATCAT_Advanced);
+
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Registered Input Actions"), STAT_ISRegisteredInputActions, STATGROUP_InputSetup, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GetInputAction Calls"), STAT_ISGetInputActionCalls, STATGROUP_InputSetup, );
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("GetInputAction Misses"), STAT_ISGetInputActionMisses, STATGROUP_InputSetup, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Registrations"), STAT_ISPendingRegistrations, STATGROUP_InputSetup, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Pending Plugin Chunks"), STAT_ISPendingPluginChunks, STATGROUP_InputSetup, );
+DECLARE_DWORD_ACCUMULATOR_STAT_EXTERN(TEXT("Restart Mapping Contexts"), STAT_ISRestartMappingContexts, STATGROUP_InputSetup, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Plugin Registration"), STAT_ISPluginRegistration, STATGROUP_InputSetup, );
+DECLARE_CYCLE_STAT_EXTERN(TEXT("OnOwnerPawnClientRestart"), STAT_ISOnOwnerPawnClientRestart, STATGROUP_InputSetup, );
+
+/**
+ * @brief Low Level Memory tracker tags for InputSetup's allocations, including assets loaded by the registry.
+ */
+LLM_DECLARE_TAG(InputSetup);
+LLM_DECLARE_TAG(InputSetup_Registry);
+LLM_DECLARE_TAG(InputSetup_BotInput);
+LLM_DECLARE_TAG(InputSetup_PawnExtension);
+
+/**
+ * @brief Insights channel for InputSetup's CPU events. Capture everything with "-trace=cpu,counters,bookmark,InputSetup":
+ *        the counters below go through the counters channel and each plugin registration is a bookmark. Like all trace
+ *        data they're compiled out without `UE_TRACE_ENABLED` (e.g. shipping by default), and the per-frame GetInputAction
+ *        counters are also compiled out without `IS_WITH_RUNTIME_STATS`. The `STAT_` stats above are only available
+ *        through the stats system ("stat InputSetup").
+ */
+UE_TRACE_CHANNEL_EXTERN(InputSetupChannel);
+
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_RegisteredInputActions);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_PendingRegistrations);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_PendingPluginChunks);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_GetInputActionCallsPerFrame);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_GetInputActionMissesPerFrame);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(InputSetup_GetInputActionMissRate);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_RestartMappingContexts);
+TRACE_DECLARE_INT_COUNTER_EXTERN(InputSetup_LastPluginRegistrationEntries);
+TRACE_DECLARE_FLOAT_COUNTER_EXTERN(InputSetup_LastPluginRegistrationMilliseconds);
+
+/**
+ * @brief Cumulative InputSetup numbers, reported by the "InputSetup.DumpStats" console command so they're readable in
+ *        headless runs without the stats system.
+ */
+class FISStats
+{
+public:
+
+    struct FPluginRegistration
+    {
+    public:
+
+        double Seconds = 0.0;
+        int32 NumEntries = 0;
+    };
+
+public:
+
+    static FISStats& Get();
+
+public:
+
+    /**
+     * @brief Start publishing per-frame numbers at the end of each frame. Called by the module.
+     */
+    void Initialize();
+
+    void Deinitialize();
+
+    FORCEINLINE void RecordGetInputAction(const bool inWasFound)
+    {
+        INC_DWORD_STAT(STAT_ISGetInputActionCalls);
+
+        if (!inWasFound)
+        {
+            INC_DWORD_STAT(STAT_ISGetInputActionMisses);
+        }
+
+#if IS_WITH_RUNTIME_STATS
+        NumGetInputActionCalls.fetch_add(1, std::memory_order_relaxed);
+        NumGetInputActionCallsThisFrame.fetch_add(1, std::memory_order_relaxed);
+
+        if (!inWasFound)
+        {
+            NumGetInputActionMisses.fetch_add(1, std::memory_order_relaxed);
+            NumGetInputActionMissesThisFrame.fetch_add(1, std::memory_order_relaxed);
+        }
+#endif // #if IS_WITH_RUNTIME_STATS
+    }
+
+    void RecordPluginRegistration(const FString& inPluginName, const double inSeconds, const int32 inNumEntries);
+
+    void RecordOwnerPawnClientRestart(const double inSeconds, const int32 inNumMappingContexts);
+
+    /**
+     * @brief Log all numbers, along with the current state of the registry.
+     */
+    void Dump(FOutputDevice& inOutputDevice) const;
+
+protected:
+
+#if IS_WITH_RUNTIME_STATS
+    /**
+     * @brief Publish this frame's GetInputAction numbers to trace and start counting the next frame's.
+     */
+    void OnEndFrame();
+#endif // #if IS_WITH_RUNTIME_STATS
+
+protected:
+
+#if IS_WITH_RUNTIME_STATS
+    std::atomic<int64> NumGetInputActionCalls = 0;
+    std::atomic<int64> NumGetInputActionMisses = 0;
+
+    std::atomic<int32> NumGetInputActionCallsThisFrame = 0;
+    std::atomic<int32> NumGetInputActionMissesThisFrame = 0;
+    int32 LastFrameNumGetInputActionCalls = 0;
+    int32 LastFrameNumGetInputActionMisses = 0;
+
+    FDelegateHandle EndFrameDelegateHandle;
+
+    TMap<FString, FPluginRegistration> PluginRegistrations;
+
+    int32 NumOwnerPawnClientRestarts = 0;
+    double TotalOwnerPawnClientRestartSeconds = 0.0;
+    double MaxOwnerPawnClientRestartSeconds = 0.0;
+    int32 LastOwnerPawnClientRestartNumMappingContexts = 0;
+#endif // #if IS_WITH_RUNTIME_STATS
+};
@@ -0,0 +1,379 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ISWorldSubsystem_BotInput.h"
+
+#include "ISEngineSubsystem_InputActionAssetReferences.h"
+#include "InputAction.h"
+#include "GameFramework/Pawn.h"
+#include "Async/ParallelFor.h"
+#include "GCUtils_Log.h"
+#include "GCUtils_String.h"
+#include "ISStats.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogISWorldSubsystem_BotInput, Log, All);
+
+UISWorldSubsystem_BotInput::UISWorldSubsystem_BotInput()
+    : BotsPerParallelBatch(256)
+{
+}
+
+void UISWorldSubsystem_BotInput::Deinitialize()
+{
+    // The engine subsystem may already be gone during shutdown.
+    if (UISEngineSubsystem_InputActionAssetReferences* inputActionAssetReferences =
+        GEngine ? GEngine->GetEngineSubsystem<UISEngineSubsystem_InputActionAssetReferences>() : nullptr)
+    {
+        for (FISBotInputActionColumn& actionColumn : ActionColumns)
+        {
+            inputActionAssetReferences->RemoveInputActionAddedListener(
+                actionColumn.Tag,
+                EGameplayTagMatchType::Explicit,
+                actionColumn.InputActionAddedListenerHandle);
+
+            inputActionAssetReferences->RemoveInputActionRemovedListener(
+                actionColumn.Tag,
+                EGameplayTagMatchType::Explicit,
+                actionColumn.InputActionRemovedListenerHandle);
+        }
+    }
+
+    ActionColumns.Empty();
+    ActionColumnIndices.Empty();
+
+    Super::Deinitialize();
+}
+
+bool UISWorldSubsystem_BotInput::DoesSupportWorldType(const EWorldType::Type inWorldType) const
+{
+    return inWorldType == EWorldType::Game || inWorldType == EWorldType::PIE;
+}
+
+void UISWorldSubsystem_BotInput::Tick(float inDeltaTime)
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISWorldSubsystem_BotInput::Tick);
+    LLM_SCOPE_BYTAG(InputSetup_BotInput);
+
+    Super::Tick(inDeltaTime);
+
+    if (NumBots <= 0)
+    {
+        return;
+    }
+
+    EvaluateActionColumns();
+    DispatchTriggerEvents();
+}
+
+TStatId UISWorldSubsystem_BotInput::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(UISWorldSubsystem_BotInput, STATGROUP_Tickables);
+}
+
+FISBotInputHandle UISWorldSubsystem_BotInput::RegisterBot(APawn& inPawn, FISBotInputActionEventNativeDelegate&& inEventDelegate)
+{
+    LLM_SCOPE_BYTAG(InputSetup_BotInput);
+
+    GC_LOG_STR_UOBJECT(
+        this,
+        LogISWorldSubsystem_BotInput,
+        Verbose,
+        WriteToString<256>(TEXT("Registering bot '"), GCUtils::String::GetUObjectPathName(inPawn), TEXT("'."))
+        );
+
+    int32 botIndex;
+    if (!FreeBotIndices.IsEmpty())
+    {
+        botIndex = FreeBotIndices.Pop(EAllowShrinking::No);
+    }
+    else
+    {
+        botIndex = BotPawns.AddDefaulted();
+        BotEventDelegates.AddDefaulted();
+        BotSerials.Add(0);
+        BotActiveFlags.Add(false);
+
+        for (FISBotInputActionColumn& actionColumn : ActionColumns)
+        {
+            actionColumn.PendingValues.Add(FVector::ZeroVector);
+            actionColumn.CurrentValues.Add(FVector::ZeroVector);
+            actionColumn.TriggerEvents.Add(0);
+        }
+    }
+
+    BotPawns[botIndex] = &inPawn;
+    BotEventDelegates[botIndex] = MoveTemp(inEventDelegate);
+    BotActiveFlags[botIndex] = true;
+    ++NumBots;
+
+    FISBotInputHandle handle;
+    handle.BotIndex = botIndex;
+    handle.Serial = ++BotSerials[botIndex];
+    return handle;
+}
+
+void UISWorldSubsystem_BotInput::UnregisterBot(FISBotInputHandle& inOutHandle)
+{
+    if (!IsBotHandleValid(inOutHandle))
+    {
+        inOutHandle = FISBotInputHandle();
+        return;
+    }
+
+    const int32 botIndex = inOutHandle.BotIndex;
+
+    BotPawns[botIndex] = nullptr;
+    BotEventDelegates[botIndex].Unbind();
+    BotActiveFlags[botIndex] = false;
+    ++BotSerials[botIndex];
+
+    for (FISBotInputActionColumn& actionColumn : ActionColumns)
+    {
+        actionColumn.PendingValues[botIndex] = FVector::ZeroVector;
+        actionColumn.CurrentValues[botIndex] = FVector::ZeroVector;
+        actionColumn.TriggerEvents[botIndex] = 0;
+    }
+
+    FreeBotIndices.Add(botIndex);
+    --NumBots;
+
+    inOutHandle = FISBotInputHandle();
+}
+
+bool UISWorldSubsystem_BotInput::SetBotInputActionValue(const FISBotInputHandle& inHandle, const FGameplayTag& inTag, const FVector& inValue)
+{
+    if (!IsBotHandleValid(inHandle))
+    {
+        return false;
+    }
+
+    const int32 actionColumnIndex = FindOrAddActionColumn(inTag);
+    if (actionColumnIndex == INDEX_NONE)
+    {
+        return false;
+    }
+
+    FISBotInputActionColumn& actionColumn = ActionColumns[actionColumnIndex];
+    if (!actionColumn.InputAction.IsValid())
+    {
+        // Its input action was removed and hasn't been added again.
+        return false;
+    }
+
+    actionColumn.PendingValues[inHandle.BotIndex] = inValue;
+    return true;
+}
+
+FInputActionValue UISWorldSubsystem_BotInput::GetBotInputActionValue(const FISBotInputHandle& inHandle, const FGameplayTag& inTag) const
+{
+    if (!IsBotHandleValid(inHandle))
+    {
+        return FInputActionValue();
+    }
+
+    const int32* foundActionColumnIndex = ActionColumnIndices.Find(inTag);
+    if (!foundActionColumnIndex)
+    {
+        return FInputActionValue();
+    }
+
+    const FISBotInputActionColumn& actionColumn = ActionColumns[*foundActionColumnIndex];
+    return FInputActionValue(actionColumn.ValueType, actionColumn.CurrentValues[inHandle.BotIndex]);
+}
+
+bool UISWorldSubsystem_BotInput::IsBotHandleValid(const FISBotInputHandle& inHandle) const
+{
+    return inHandle.IsValid()
+        && BotSerials.IsValidIndex(inHandle.BotIndex)
+        && BotSerials[inHandle.BotIndex] == inHandle.Serial
+        && BotActiveFlags[inHandle.BotIndex];
+}
+
+int32 UISWorldSubsystem_BotInput::FindOrAddActionColumn(const FGameplayTag& inTag)
+{
+    if (const int32* foundActionColumnIndex = ActionColumnIndices.Find(inTag))
+    {
+        return *foundActionColumnIndex;
+    }
+
+    LLM_SCOPE_BYTAG(InputSetup_BotInput);
+
+    UISEngineSubsystem_InputActionAssetReferences& inputActionAssetReferences = UISEngineSubsystem_InputActionAssetReferences::GetChecked(*GEngine);
+
+    const UInputAction* inputAction = inputActionAssetReferences.GetInputAction(inTag);
+    if (!inputAction)
+    {
+        GC_LOG_STR_UOBJECT(
+            this,
+            LogISWorldSubsystem_BotInput,
+            Warning,
+            WriteToString<256>(TEXT("No input action registered for tag '"), inTag.GetTagName(), TEXT("'."))
+            );
+        return INDEX_NONE;
+    }
+
+    const int32 actionColumnIndex = ActionColumns.AddDefaulted();
+    FISBotInputActionColumn& actionColumn = ActionColumns[actionColumnIndex];
+
+    actionColumn.Tag = inTag;
+    actionColumn.InputAction = inputAction;
+    actionColumn.ValueType = inputAction->ValueType;
+    actionColumn.PendingValues.Init(FVector::ZeroVector, BotSerials.Num());
+    actionColumn.CurrentValues.Init(FVector::ZeroVector, BotSerials.Num());
+    actionColumn.TriggerEvents.Init(0, BotSerials.Num());
+
+    actionColumn.InputActionAddedListenerHandle = inputActionAssetReferences.AddInputActionAddedListener(
+        inTag,
+        EGameplayTagMatchType::Explicit,
+        FISReferencedInputActionNativeDelegate::FDelegate::CreateUObject(this, &ThisClass::OnActionColumnInputActionAdded));
+
+    actionColumn.InputActionRemovedListenerHandle = inputActionAssetReferences.AddInputActionRemovedListener(
+        inTag,
+        EGameplayTagMatchType::Explicit,
+        FISReferencedInputActionNativeDelegate::FDelegate::CreateUObject(this, &ThisClass::OnActionColumnInputActionRemoved));
+
+    ActionColumnIndices.Emplace(inTag, actionColumnIndex);
+    return actionColumnIndex;
+}
+
+void UISWorldSubsystem_BotInput::OnActionColumnInputActionAdded(const FGameplayTag& inTag, const UInputAction& inInputAction)
+{
+    const int32* foundActionColumnIndex = ActionColumnIndices.Find(inTag);
+    if (!foundActionColumnIndex)
+    {
+        return;
+    }
+
+    FISBotInputActionColumn& actionColumn = ActionColumns[*foundActionColumnIndex];
+    actionColumn.InputAction = &inInputAction;
+    actionColumn.ValueType = inInputAction.ValueType;
+}
+
+void UISWorldSubsystem_BotInput::OnActionColumnInputActionRemoved(const FGameplayTag& inTag, const UInputAction& inInputAction)
+{
+    const int32* foundActionColumnIndex = ActionColumnIndices.Find(inTag);
+    if (!foundActionColumnIndex)
+    {
+        return;
+    }
+
+    // The action may stay loaded (e.g. referenced elsewhere), so don't rely on the weak pointer going stale.
+    FISBotInputActionColumn& actionColumn = ActionColumns[*foundActionColumnIndex];
+    actionColumn.InputAction = nullptr;
+
+    for (int32 botIndex = 0; botIndex < actionColumn.TriggerEvents.Num(); ++botIndex)
+    {
+        actionColumn.PendingValues[botIndex] = FVector::ZeroVector;
+        actionColumn.CurrentValues[botIndex] = FVector::ZeroVector;
+        actionColumn.TriggerEvents[botIndex] = 0;
+    }
+}
+
+void UISWorldSubsystem_BotInput::EvaluateActionColumns()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISWorldSubsystem_BotInput::EvaluateActionColumns);
+
+    const int32 numBotIndices = BotSerials.Num();
+
+    for (FISBotInputActionColumn& actionColumn : ActionColumns)
+    {
+        const FVector* pendingValues = actionColumn.PendingValues.GetData();
+        FVector* currentValues = actionColumn.CurrentValues.GetData();
+        uint8* triggerEvents = actionColumn.TriggerEvents.GetData();
+
+        ParallelFor(
+            TEXT("UISWorldSubsystem_BotInput::EvaluateActionColumns"),
+            numBotIndices,
+            FMath::Max(BotsPerParallelBatch, 1),
+            [pendingValues, currentValues, triggerEvents](const int32 inBotIndex)
+            {
+                const bool wasActuated = !currentValues[inBotIndex].IsNearlyZero();
+                const bool isActuated = !pendingValues[inBotIndex].IsNearlyZero();
+
+                uint8 events = 0;
+                if (isActuated)
+                {
+                    if (!wasActuated)
+                    {
+                        events |= static_cast<uint8>(ETriggerEvent::Started);
+                    }
+
+                    events |= static_cast<uint8>(ETriggerEvent::Triggered);
+                }
+                else if (wasActuated)
+                {
+                    events |= static_cast<uint8>(ETriggerEvent::Completed);
+                }
+
+                currentValues[inBotIndex] = pendingValues[inBotIndex];
+                triggerEvents[inBotIndex] = events;
+            }
+            );
+    }
+}
+
+void UISWorldSubsystem_BotInput::DispatchTriggerEvents()
+{
+    TRACE_CPUPROFILER_EVENT_SCOPE(UISWorldSubsystem_BotInput::DispatchTriggerEvents);
+
+    // In the order Enhanced Input broadcasts them.
+    static constexpr ETriggerEvent triggerEventsInOrder[] =
+    {
+        ETriggerEvent::Started,
+        ETriggerEvent::Triggered,
+        ETriggerEvent::Completed,
+    };
+
+    // Iterate by index since delegates may register or unregister bots and add columns.
+    for (int32 actionColumnIndex = 0; actionColumnIndex < ActionColumns.Num(); ++actionColumnIndex)
+    {
+        const UInputAction* inputAction = ActionColumns[actionColumnIndex].InputAction.Get();
+        if (!inputAction)
+        {
+            continue;
+        }
+
+        const FGameplayTag tag = ActionColumns[actionColumnIndex].Tag;
+        const EInputActionValueType valueType = ActionColumns[actionColumnIndex].ValueType;
+
+        for (int32 botIndex = 0; botIndex < ActionColumns[actionColumnIndex].TriggerEvents.Num(); ++botIndex)
+        {
+            const uint8 events = ActionColumns[actionColumnIndex].TriggerEvents[botIndex];
+            if (events == 0 || !BotActiveFlags[botIndex])
+            {
+                continue;
+            }
+
+            APawn* pawn = BotPawns[botIndex].Get();
+            if (!pawn)
+            {
+                // Its owner destroyed the pawn without unregistering it.
+                FISBotInputHandle handle;
+                handle.BotIndex = botIndex;
+                handle.Serial = BotSerials[botIndex];
+                UnregisterBot(handle);
+                continue;
+            }
+
+            // Copy since the delegate is allowed to unregister its bot.
+            const FISBotInputActionEventNativeDelegate eventDelegate = BotEventDelegates[botIndex];
+            const FInputActionValue value(valueType, ActionColumns[actionColumnIndex].CurrentValues[botIndex]);
+            const uint32 serial = BotSerials[botIndex];
+
+            for (const ETriggerEvent triggerEvent : triggerEventsInOrder)
+            {
+                if (!(events & static_cast<uint8>(triggerEvent)))
+                {
+                    continue;
+                }
+
+                // Stop once an earlier event unregistered the bot, even if another bot took its index.
+                if (!BotActiveFlags[botIndex] || BotSerials[botIndex] != serial)
+                {
+                    break;
+                }
+
+                eventDelegate.ExecuteIfBound(*pawn, tag, *inputAction, triggerEvent, value);
+            }
+        }
+    }
+}
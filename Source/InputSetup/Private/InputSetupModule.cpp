@@ -2,13 +2,19 @@
 
 #include "InputSetupModule.h"
 
+#include "ISStats.h"
+
 void FInputSetupModule::StartupModule()
 {
     IModuleInterface::StartupModule();
+
+    FISStats::Get().Initialize();
 }
 
 void FInputSetupModule::ShutdownModule()
 {
+    FISStats::Get().Deinitialize();
+
     IModuleInterface::ShutdownModule();
 }
 
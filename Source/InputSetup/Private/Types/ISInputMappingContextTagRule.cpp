@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Types/ISInputMappingContextTagRule.h"
+
+bool FISInputMappingContextTagRule::DoesMatch(const FGameplayTagContainer& inOwnerTags) const
+{
+    return inOwnerTags.HasAll(RequiredTags) && !inOwnerTags.HasAny(BlockedTags);
+}
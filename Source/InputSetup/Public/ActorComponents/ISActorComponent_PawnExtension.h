@@ -5,9 +5,61 @@
 #include "CoreMinimal.h"
 #include "Components/ActorComponent.h"
 #include "Types/ISInputMappingContextAddArgs.h"
+#include "Types/ISInputActionBindingArgs.h"
+#include "Types/ISInputMappingContextTagRule.h"
 
 #include "ISActorComponent_PawnExtension.generated.h"
 
+class UInputAction;
+class UEnhancedInputComponent;
+class UEnhancedInputLocalPlayerSubsystem;
+
+/**
+ * @brief Runtime state of one of the pawn extension's input action bindings. Kept across restarts so that input
+ *        actions are only resolved once and the storage is reused.
+ */
+struct FISInputActionBindingState
+{
+public:
+
+    /**
+     * @brief The tag of the binding this state was made for, which our listeners are registered with.
+     */
+    FGameplayTag InputActionTag;
+
+    TWeakObjectPtr<const UInputAction> ResolvedInputAction = nullptr;
+
+    FDelegateHandle InputActionAddedListenerHandle;
+    FDelegateHandle InputActionRemovedListenerHandle;
+
+    uint32 BindingHandle = 0;
+    bool bIsBound = false;
+};
+
+/**
+ * @brief How often client restarts of pawns found their input already prewarmed by
+ *        `UISActorComponent_PawnExtension::PrewarmForUpcomingPossession()`.
+ */
+struct INPUTSETUP_API FISPossessionPrewarmStats
+{
+public:
+
+    /**
+     * @brief Restarts that were prewarmed and had all input actions resolved.
+     */
+    int32 NumHits = 0;
+
+    /**
+     * @brief Restarts that were prewarmed but still had input actions to resolve.
+     */
+    int32 NumMisses = 0;
+
+    /**
+     * @brief Restarts that weren't prewarmed at all.
+     */
+    int32 NumNotPrewarmed = 0;
+};
+
 /**
  * @brief Sets up input for pawns.
  */
@@ -20,6 +72,12 @@ public:
 
     UISActorComponent_PawnExtension(const FObjectInitializer& ObjectInitializer);
 
+protected:
+
+    // ~ UActorComponent overrides.
+    virtual void EndPlay(const EEndPlayReason::Type inEndPlayReason) override;
+    // ~ UActorComponent overrides.
+
 public:
 
     /**
@@ -27,6 +85,103 @@ public:
      */
     void OnOwnerPawnClientRestart();
 
+public:
+
+    /**
+     * @brief Bind all of `InputActionBindings` to the owner pawn's input component. Input actions that
+     *        aren't registered yet get bound once they are. Called for you by `OnOwnerPawnClientRestart()`.
+     */
+    void BindInputActions();
+
+    /**
+     * @brief Remove all of our input action bindings and stop listening for input action changes.
+     */
+    void UnbindInputActions();
+
+public:
+
+    /**
+     * @brief Hint that the owner pawn is likely to be possessed soon (e.g. the player is near it or focusing it).
+     *        Resolves our input actions from the registry ahead of time, moving any still pending registration to the
+     *        front of the queue, so that the client restart only has to apply them.
+     */
+    void PrewarmForUpcomingPossession();
+
+    /**
+     * @brief The hinted possession is no longer expected.
+     */
+    void CancelPossessionPrewarm();
+
+    static const FISPossessionPrewarmStats& GetPossessionPrewarmStats();
+
+public:
+
+    /**
+     * @brief Replace the owner's gameplay tags used by `InputMappingContextTagRules`.
+     */
+    void SetOwnerGameplayTags(const FGameplayTagContainer& inOwnerGameplayTags);
+
+    /**
+     * @brief Update one of the owner's gameplay tags used by `InputMappingContextTagRules`. Has the same signature as
+     *        ability system tag events so it can be bound to them directly.
+     */
+    void OnOwnerGameplayTagCountChanged(const FGameplayTag inTag, int32 inNewCount);
+
+protected:
+
+    UEnhancedInputLocalPlayerSubsystem* GetEnhancedInputLocalPlayerSubsystem() const;
+
+    UEnhancedInputComponent* GetOwnerEnhancedInputComponent() const;
+
+    /**
+     * @brief Schedule `UpdateInputMappingContextTagRules()` for the next tick, if not already. Coalesces any
+     *        number of tag changes within a frame into one update.
+     */
+    void RequestInputMappingContextTagRulesUpdate();
+
+    /**
+     * @brief Add and remove the input mapping contexts of `InputMappingContextTagRules` that started or stopped matching.
+     */
+    void UpdateInputMappingContextTagRules();
+
+    /**
+     * @brief Remove the bindings from the input component, keeping the resolved input actions.
+     */
+    void RemoveInputActionBindings();
+
+    /**
+     * @brief Remake our binding states if they don't match `InputActionBindings` (e.g. an entry was inserted, removed or
+     *        given another tag since they were made).
+     */
+    void SyncInputActionBindingStates();
+
+    /**
+     * @return The binding's input action, looking it up in the registry only if not already resolved.
+     */
+    const UInputAction* ResolveInputActionBinding(const int32 inBindingIndex);
+
+    /**
+     * @return True if all of `InputActionBindings` have their input action resolved.
+     */
+    bool AreAllInputActionBindingsResolved() const;
+
+    /**
+     * @brief Record whether this restart was prewarmed.
+     */
+    void RecordPossessionPrewarmResult();
+
+    void TryBindInputAction(const int32 inBindingIndex, UEnhancedInputComponent& inEnhancedInputComponent);
+
+    void RemoveInputActionBinding(const int32 inBindingIndex);
+
+    void StartListeningForInputActionChanges();
+
+    void StopListeningForInputActionChanges();
+
+    void OnBindingInputActionAdded(const FGameplayTag& inTag, const UInputAction& inInputAction, const int32 inBindingIndex);
+
+    void OnBindingInputActionRemoved(const FGameplayTag& inTag, const UInputAction& inInputAction, const int32 inBindingIndex);
+
 public:
 
     /**
@@ -36,4 +191,45 @@ public:
      */
     UPROPERTY(EditAnywhere, Category = "InputSetup")
     TArray<FISInputMappingContextAddArgs> InputMappingContextsToAdd;
+
+    /**
+     * @brief Input actions to bind to the owner pawn's functions, looked up by gameplay tag.
+     */
+    UPROPERTY(EditAnywhere, Category = "InputSetup")
+    TArray<FISInputActionBindingArgs> InputActionBindings;
+
+    /**
+     * @brief Input mapping contexts to add and remove as the owner's gameplay tags change. The owner's tags must be
+     *        given to us through `SetOwnerGameplayTags()` or `OnOwnerGameplayTagCountChanged()`.
+     */
+    UPROPERTY(EditAnywhere, Category = "InputSetup")
+    TArray<FISInputMappingContextTagRule> InputMappingContextTagRules;
+
+protected:
+
+    /**
+     * @brief Runtime state for each of `InputActionBindings`, by index.
+     */
+    TArray<FISInputActionBindingState> InputActionBindingStates;
+
+    /**
+     * @brief The input component our bindings were made on.
+     */
+    TWeakObjectPtr<UEnhancedInputComponent> BoundEnhancedInputComponent = nullptr;
+
+    /**
+     * @brief The owner's gameplay tags as last given to us.
+     */
+    FGameplayTagContainer OwnerGameplayTags;
+
+    /**
+     * @brief Whether each of `InputMappingContextTagRules` currently has its input mapping context added, by index.
+     */
+    TBitArray<> AppliedInputMappingContextTagRules;
+
+    FTimerHandle InputMappingContextTagRulesUpdateTimerHandle;
+
+    uint8 bIsListeningForInputActionChanges : 1;
+    uint8 bIsInputMappingContextTagRulesUpdatePending : 1;
+    uint8 bIsPrewarmedForPossession : 1;
 };
@@ -4,6 +4,8 @@
 
 #include "CoreMinimal.h"
 #include "Subsystems/EngineSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "Containers/Ticker.h"
 
 #include "ISEngineSubsystem_InputActionAssetReferences.generated.h"
 
@@ -17,6 +19,105 @@ DECLARE_MULTICAST_DELEGATE_TwoParams(FISReferencedInputActionNativeDelegate,
     const FGameplayTag& /* inTag */,
     const UInputAction& /* inInputAction */);
 
+/**
+ * @brief Table of input action listeners indexed by the gameplay tag they are interested in. Used so that
+ *        adding or removing an input action only wakes up the listeners that care about its tag.
+ */
+struct INPUTSETUP_API FISReferencedInputActionListenerTable
+{
+public:
+
+    FDelegateHandle Add(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate);
+
+    /**
+     * @return True if there was a listener to remove.
+     */
+    bool Remove(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        const FDelegateHandle& inDelegateHandle);
+
+    /**
+     * @brief Broadcast to the listeners of the tag as well as the listeners of any of its parent tags
+     *        which asked to include child tags.
+     */
+    void Broadcast(const FGameplayTag& inTag, const UInputAction& inInputAction) const;
+
+    FORCEINLINE bool IsEmpty() const
+    {
+        return ExplicitTagListeners.IsEmpty() && ParentTagListeners.IsEmpty();
+    }
+
+protected:
+
+    /**
+     * @brief Listeners only interested in their exact tag.
+     */
+    TMap<FGameplayTag, FISReferencedInputActionNativeDelegate> ExplicitTagListeners;
+
+    /**
+     * @brief Listeners interested in their tag and all of its child tags.
+     */
+    TMap<FGameplayTag, FISReferencedInputActionNativeDelegate> ParentTagListeners;
+};
+
+/**
+ * @brief Results of interning input action subobjects (triggers and modifiers).
+ */
+struct INPUTSETUP_API FISInputActionSubobjectInterningStats
+{
+public:
+
+    /**
+     * @brief Number of subobject instances that were replaced by a shared instance, minus the number of shared
+     *        instances created.
+     */
+    int32 NumObjectsSaved = 0;
+
+    /**
+     * @brief Approximate number of bytes saved by `NumObjectsSaved`.
+     */
+    int64 NumBytesSaved = 0;
+};
+
+/**
+ * @brief An input action of an asset references data asset waiting to be added. The pointers are kept alive by the
+ *        data asset being in `UISEngineSubsystem_InputActionAssetReferences::AssetReferencesDataAssets`.
+ */
+struct FISPendingInputActionRegistration
+{
+public:
+
+    FGameplayTag Tag;
+
+    const UInputAction* InputAction = nullptr;
+
+    const UISPrimaryDataAsset_InputActionAssetReferences* DataAsset = nullptr;
+};
+
+/**
+ * @brief A plugin whose asset references data asset still has input actions waiting to be added, so that its
+ *        registration can be reported once the last one is.
+ */
+struct FISPendingPluginRegistration
+{
+public:
+
+    FString PluginName;
+
+    /**
+     * @brief When the plugin's content was first added, including any time spent waiting for its chunk.
+     */
+    double StartTime = 0.0;
+
+    int32 NumEntries = 0;
+
+    int32 NumPendingEntries = 0;
+};
+
 /**
  * @brief Subsystem holding references to all input actions which can be retrieved
  *        by gameplay tag. Holds all input actions for the game.
@@ -53,6 +154,9 @@ public:
     static FSoftObjectPath GetAssetReferenceDataAssetPathForPlugin(
         const TSharedRef<const IPlugin>& inPlugin);
 
+    static FPrimaryAssetId GetAssetReferenceDataAssetPrimaryAssetIdForPlugin(
+        const TSharedRef<const IPlugin>& inPlugin);
+
 public:
 
     /**
@@ -60,11 +164,120 @@ public:
      */
     const UInputAction* GetInputAction(const FGameplayTag& inTag) const;
 
-    FORCEINLINE const TMap<FGameplayTag, TObjectPtr<const UInputAction>>& GetAllInputActions() const
+    /**
+     * @brief All input actions by tag. Builds the map on each call, so prefer `GetAllInputActionsArray()` and
+     *        `GetAllInputActionTags()` where it matters.
+     */
+    TMap<FGameplayTag, TObjectPtr<const UInputAction>> GetAllInputActions() const;
+
+    /**
+     * @brief All input actions, in the same order as `GetAllInputActionTags()`.
+     */
+    FORCEINLINE TConstArrayView<TObjectPtr<const UInputAction>> GetAllInputActionsArray() const
     {
         return ReferencedInputActions;
     }
 
+    /**
+     * @brief The tags of all input actions, in the same order as `GetAllInputActionsArray()`.
+     */
+    FORCEINLINE TConstArrayView<FGameplayTag> GetAllInputActionTags() const
+    {
+        return ReferencedInputActionTags;
+    }
+
+    FORCEINLINE TConstArrayView<TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>> GetAllAssetReferencesDataAssets() const
+    {
+        return AssetReferencesDataAssets;
+    }
+
+    /**
+     * @return True if the tag's input action is waiting to be added by the time-sliced registration.
+     */
+    FORCEINLINE bool IsInputActionRegistrationPending(const FGameplayTag& inTag) const
+    {
+        return PendingInputActionRegistrationTags.Contains(inTag);
+    }
+
+    FORCEINLINE int32 GetNumPendingInputActionRegistrations() const
+    {
+        return PendingInputActionRegistrationTags.Num();
+    }
+
+    /**
+     * @return The number of plugins whose asset references are waiting for their content chunk to be installed.
+     */
+    FORCEINLINE int32 GetNumDeferredPluginChunks() const
+    {
+        return DeferredPluginChunkIds.Num();
+    }
+
+    /**
+     * @brief If the tag's input action is waiting to be added by the time-sliced registration, move it to be added next.
+     * @return True if it was pending.
+     */
+    bool PrioritizePendingInputActionRegistration(const FGameplayTag& inTag);
+
+    FORCEINLINE const FISInputActionSubobjectInterningStats& GetInputActionSubobjectInterningStats() const
+    {
+        return InputActionSubobjectInterningStats;
+    }
+
+public:
+
+    /**
+     * @brief Listen for input actions being added under a tag. Unlike `OnInputActionAddedDelegate`, the
+     *        listener is only called for matching tags.
+     * @param inMatchType Use `IncludeParentTags` to also be called for the tag's child tags.
+     * @param inShouldCallForExisting If true, the listener is called immediately for all matching input
+     *        actions that have already been added.
+     */
+    FDelegateHandle AddInputActionAddedListener(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate,
+        const bool inShouldCallForExisting = false);
+
+    /**
+     * @brief Listen for input actions being removed under a tag. Unlike `OnInputActionRemovedDelegate`,
+     *        the listener is only called for matching tags.
+     * @param inMatchType Use `IncludeParentTags` to also be called for the tag's child tags.
+     */
+    FDelegateHandle AddInputActionRemovedListener(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        FISReferencedInputActionNativeDelegate::FDelegate&& inDelegate);
+
+    /**
+     * @brief Stop listening. The tag and match type must be the same as when the listener was added.
+     * @return True if there was a listener to remove.
+     */
+    bool RemoveInputActionAddedListener(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        const FDelegateHandle& inDelegateHandle);
+
+    /**
+     * @brief Stop listening. The tag and match type must be the same as when the listener was added.
+     * @return True if there was a listener to remove.
+     */
+    bool RemoveInputActionRemovedListener(
+        const FGameplayTag& inTag,
+        const EGameplayTagMatchType inMatchType,
+        const FDelegateHandle& inDelegateHandle);
+
+protected:
+
+    /**
+     * @brief Same as `GetInputAction()` but without counting towards stats, for our own lookups.
+     */
+    const UInputAction* FindInputAction(const FGameplayTag& inTag) const;
+
+    /**
+     * @brief Update the registry's stats and trace counters to its current state.
+     */
+    void UpdateRegistryStats() const;
+
 protected:
 
     /**
@@ -101,6 +314,47 @@ protected:
     bool TryRemoveReferencedAssetsDataAsset(
         const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset);
 
+protected:
+
+    /**
+     * @brief Queue the data asset's input actions to be added over the next frames, within `RegistrationFrameBudgetMilliseconds`.
+     */
+    void EnqueuePendingInputActionRegistrations(
+        const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset);
+
+    /**
+     * @brief Drop all of the data asset's input actions that are still waiting to be added.
+     * @return The tags of the registrations dropped.
+     */
+    TSet<FGameplayTag> RemovePendingInputActionRegistrations(
+        const UISPrimaryDataAsset_InputActionAssetReferences& inDataAsset);
+
+    /**
+     * @brief Add pending input actions until the frame budget is used up, priority ones first.
+     * @return True to keep ticking.
+     */
+    bool TickPendingInputActionRegistrations(float inDeltaTime);
+
+protected:
+
+    /**
+     * @brief Replace the input action's triggers and modifiers with shared instances of structurally identical ones.
+     */
+    void InternInputActionSubobjects(UInputAction& inInputAction);
+
+    /**
+     * @return The shared instance which is structurally identical to the given subobject. Creates one if needed.
+     */
+    UObject& FindOrAddInternedInputActionSubobject(UObject& inSubobject);
+
+    /**
+     * @brief Release the input action's uses of shared instances, dropping any shared instance no longer used by
+     *        a registered input action.
+     */
+    void ReleaseInternedInputActionSubobjects(const UInputAction& inInputAction);
+
+    void ReleaseInternedInputActionSubobject(const UObject& inSubobject);
+
 protected:
 
     void OnAssetManagerCreated();
@@ -112,12 +366,28 @@ protected:
      */
     void AddGameProjectAssetReferences(UAssetManager& inAssetManager);
 
+#if WITH_EDITOR
+    /**
+     * @brief Assign each configured plugin's asset references data asset, and with it the input actions it
+     *        references, to the plugin's chunk.
+     */
+    void ApplyPluginContentChunkRules(UAssetManager& inAssetManager) const;
+#endif // #if WITH_EDITOR
+
 protected:
 
     void OnPluginAddContent(TSharedRef<IPlugin>&& inPlugin);
 
     void OnPluginRemoveContent(TSharedRef<IPlugin>&& inPlugin);
 
+    /**
+     * @return True if the plugin's content chunk isn't installed yet, in which case adding its content is deferred
+     *         until it is.
+     */
+    bool TryDeferPluginAddContentUntilChunkInstalled(const TSharedRef<IPlugin>& inPlugin);
+
+    void OnChunkInstalled(uint32 inChunkId, bool inSuccess);
+
 protected:
 
     /**
@@ -127,28 +397,127 @@ protected:
     TMap<FGameplayTag, TSoftObjectPtr<const UInputAction>> GameProjectInputActionReferences;
 
     /**
-     * @brief Container of all referenced assets.
+     * @brief If enabled, structurally identical triggers and modifiers of added input actions are deduplicated
+     *        into shared instances. Never done in the editor since it would modify the assets.
+     */
+    UPROPERTY(EditDefaultsOnly, Config, Category = "InputSetup")
+    uint8 bShouldInternInputActionSubobjects : 1;
+
+    /**
+     * @brief Chunk to cook each plugin's asset references data asset and its input actions into, by plugin name. Plugins
+     *        whose chunk isn't installed when their content is added get their references added once it's installed.
+     */
+    UPROPERTY(EditDefaultsOnly, Config, Category = "InputSetup")
+    TMap<FString, int32> PluginContentChunkIds;
+
+    /**
+     * @brief Max time per frame to spend adding input actions of asset references data assets. If zero, all of a data
+     *        asset's input actions are added immediately.
+     */
+    UPROPERTY(EditDefaultsOnly, Config, Category = "InputSetup", meta = (ClampMin = "0", Units = "Milliseconds"))
+    float RegistrationFrameBudgetMilliseconds;
+
+    /**
+     * @brief Input actions with these tags (or their child tags) are added before any others when time-slicing registration.
+     */
+    UPROPERTY(EditDefaultsOnly, Config, Category = "InputSetup")
+    FGameplayTagContainer PriorityRegistrationTags;
+
+    /**
+     * @brief Container of all referenced assets. Kept as a compact array, rather than a map, so the garbage collector
+     *        walks one contiguous block of references instead of a sparse hash container. Removal swaps with the last element.
      * @todo Use `std::reference_wrapper<>` for the input action pointers.
      */
     UPROPERTY(Transient)
-    TMap<FGameplayTag, TObjectPtr<const UInputAction>> ReferencedInputActions;
+    TArray<TObjectPtr<const UInputAction>> ReferencedInputActions;
+
+    /**
+     * @brief Tag of each of `ReferencedInputActions`, by the same index.
+     */
+    TArray<FGameplayTag> ReferencedInputActionTags;
+
+    /**
+     * @brief Index into `ReferencedInputActions` by tag. Holds no object references so it's invisible to the garbage collector.
+     */
+    TMap<FGameplayTag, int32> ReferencedInputActionIndices;
 
     /**
      * @brief External contributions to our input action references.
      * @todo Use `std::reference_wrapper<>` for the asset pointers.
      */
     UPROPERTY(VisibleDefaultsOnly, Category = "InputSetup", DisplayName = "Asset Reference Data Assets (Read-Only)")
-    TSet<TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>> AssetReferencesDataAssetSet;
+    TArray<TObjectPtr<const UISPrimaryDataAsset_InputActionAssetReferences>> AssetReferencesDataAssets;
+
+    /**
+     * @brief Shared instances of input action triggers and modifiers, owned by us.
+     */
+    UPROPERTY(Transient)
+    TArray<TObjectPtr<UObject>> InternedInputActionSubobjects;
+
+    /**
+     * @brief `InternedInputActionSubobjects` bucketed by class, so a subobject is only compared against shared
+     *        instances of its own class. Kept alive by `InternedInputActionSubobjects`.
+     */
+    TMap<const UClass*, TArray<UObject*>> InternedInputActionSubobjectsByClass;
+
+    /**
+     * @brief Number of uses by registered input actions of each of `InternedInputActionSubobjects`.
+     */
+    TMap<const UObject*, int32> InternedInputActionSubobjectUseCounts;
+
+    FISInputActionSubobjectInterningStats InputActionSubobjectInterningStats;
+
+    /**
+     * @brief Input actions waiting to be added. Stored in reverse so the next one to add is at the back.
+     */
+    TArray<FISPendingInputActionRegistration> PendingPriorityInputActionRegistrations;
+    TArray<FISPendingInputActionRegistration> PendingInputActionRegistrations;
+
+    /**
+     * @brief Tags of all pending input action registrations.
+     */
+    TSet<FGameplayTag> PendingInputActionRegistrationTags;
+
+    FTSTicker::FDelegateHandle PendingInputActionRegistrationsTickerHandle;
+
+    /**
+     * @brief Plugins with pending input action registrations, by their data asset.
+     */
+    TMap<const UISPrimaryDataAsset_InputActionAssetReferences*, FISPendingPluginRegistration> PendingPluginRegistrations;
+
+    /**
+     * @brief Plugins waiting for their content chunk to be installed, by plugin name.
+     */
+    TMap<FString, int32> DeferredPluginChunkIds;
+
+    /**
+     * @brief When each of `DeferredPluginChunkIds` had its content added, by plugin name.
+     */
+    TMap<FString, double> DeferredPluginStartTimes;
+
+    FDelegateHandle ChunkInstallDelegateHandle;
+
+    /**
+     * @brief Tag-filtered listeners for added input actions.
+     */
+    FISReferencedInputActionListenerTable InputActionAddedListeners;
+
+    /**
+     * @brief Tag-filtered listeners for removed input actions.
+     */
+    FISReferencedInputActionListenerTable InputActionRemovedListeners;
 
 public:
 
     /**
-     * @brief Delegate broadcasted when a new input action reference is added.
+     * @brief Delegate broadcasted when a new input action reference is added. Prefer
+     *        `AddInputActionAddedListener()` if you only care about specific tags.
      */
     FISReferencedInputActionNativeDelegate OnInputActionAddedDelegate;
 
     /**
-     * @brief Delegate broadcasted when a existing input action reference is removed.
+     * @brief Delegate broadcasted when a existing input action reference is removed. Prefer
+     *        `AddInputActionRemovedListener()` if you only care about specific tags.
      */
     FISReferencedInputActionNativeDelegate OnInputActionRemovedDelegate;
 };
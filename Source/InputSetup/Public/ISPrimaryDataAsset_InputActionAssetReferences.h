@@ -13,12 +13,24 @@ class UInputAction;
 /**
  * @brief Plugins can use this data asset to contribute to the game's asset references. This asset
  *        must be used as "Input/IAAR_<plugin-name>" where "<plugin-name>" is the name of your plugin.
+ *
+ *        The asset is a primary asset of type `PrimaryAssetType` so that it and the input actions it references can be
+ *        assigned to the plugin's chunk (see `UISEngineSubsystem_InputActionAssetReferences::PluginContentChunkIds`).
+ *        This is the default type of primary data assets (the native class name), so existing assets are found by the
+ *        asset manager without having to be re-saved.
  */
 UCLASS(Const)
 class INPUTSETUP_API UISPrimaryDataAsset_InputActionAssetReferences : public UPrimaryDataAsset
 {
     GENERATED_BODY()
 
+public:
+
+    /**
+     * @brief The type `UPrimaryDataAsset::GetPrimaryAssetId()` gives this class.
+     */
+    static const FPrimaryAssetType PrimaryAssetType;
+
 public:
 
     UPROPERTY(EditDefaultsOnly)
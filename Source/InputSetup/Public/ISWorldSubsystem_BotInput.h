@@ -0,0 +1,201 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GameplayTagContainer.h"
+#include "InputActionValue.h"
+#include "InputTriggers.h"
+
+#include "ISWorldSubsystem_BotInput.generated.h"
+
+class APawn;
+class UInputAction;
+
+DECLARE_DELEGATE_FiveParams(FISBotInputActionEventNativeDelegate,
+    APawn& /* inPawn */,
+    const FGameplayTag& /* inTag */,
+    const UInputAction& /* inInputAction */,
+    const ETriggerEvent /* inTriggerEvent */,
+    const FInputActionValue& /* inValue */);
+
+/**
+ * @brief Identifies a bot registered with `UISWorldSubsystem_BotInput`.
+ */
+struct INPUTSETUP_API FISBotInputHandle
+{
+public:
+
+    FORCEINLINE bool IsValid() const
+    {
+        return BotIndex != INDEX_NONE;
+    }
+
+public:
+
+    int32 BotIndex = INDEX_NONE;
+
+    /**
+     * @brief Distinguishes this bot from other bots that used the same index before or after it.
+     */
+    uint32 Serial = 0;
+};
+
+/**
+ * @brief Values of one input action for all bots, indexed by bot index.
+ */
+struct FISBotInputActionColumn
+{
+public:
+
+    FGameplayTag Tag;
+
+    TWeakObjectPtr<const UInputAction> InputAction = nullptr;
+
+    EInputActionValueType ValueType = EInputActionValueType::Boolean;
+
+    /**
+     * @brief Our listeners for the tag's input action being removed (e.g. its plugin being unmounted) and added again.
+     */
+    FDelegateHandle InputActionAddedListenerHandle;
+    FDelegateHandle InputActionRemovedListenerHandle;
+
+    /**
+     * @brief Values set by callers, applied on the next tick. Held until set again.
+     */
+    TArray<FVector> PendingValues;
+
+    /**
+     * @brief Values as of the last tick.
+     */
+    TArray<FVector> CurrentValues;
+
+    /**
+     * @brief `ETriggerEvent` flags produced by the last tick, to be dispatched.
+     */
+    TArray<uint8> TriggerEvents;
+};
+
+/**
+ * @brief Drives input actions for bots, which don't have a local player and so can't go through
+ *        `UEnhancedInputLocalPlayerSubsystem`. Input actions are identified by their tag in
+ *        `UISEngineSubsystem_InputActionAssetReferences`.
+ *
+ *        All bots' values are stored per input action in contiguous arrays and are evaluated in parallel each tick,
+ *        after which trigger events are dispatched to each bot's delegate on the game thread. Bots whose pawn has been
+ *        destroyed are unregistered instead of being dispatched to. Trigger evaluation is simplified to the behavior of
+ *        an input action without triggers: started and triggered when the value becomes non-zero, triggered while
+ *        non-zero and completed when it returns to zero.
+ */
+UCLASS(Config="ISWorldSubsystem_BotInput")
+class INPUTSETUP_API UISWorldSubsystem_BotInput : public UTickableWorldSubsystem
+{
+    GENERATED_BODY()
+
+public:
+
+    UISWorldSubsystem_BotInput();
+
+protected:
+
+    // ~ USubsystem overrides.
+    virtual void Deinitialize() override;
+    // ~ USubsystem overrides.
+
+    // ~ UWorldSubsystem overrides.
+    virtual bool DoesSupportWorldType(const EWorldType::Type inWorldType) const override;
+    // ~ UWorldSubsystem overrides.
+
+    // ~ FTickableGameObject overrides.
+    virtual void Tick(float inDeltaTime) override;
+    virtual TStatId GetStatId() const override;
+    // ~ FTickableGameObject overrides.
+
+public:
+
+    /**
+     * @brief Register a bot to receive input action events for its pawn through the given delegate.
+     */
+    FISBotInputHandle RegisterBot(APawn& inPawn, FISBotInputActionEventNativeDelegate&& inEventDelegate);
+
+    /**
+     * @brief Unregister a bot, invalidating its handle. No events are dispatched for it afterwards.
+     */
+    void UnregisterBot(FISBotInputHandle& inOutHandle);
+
+    /**
+     * @brief Set the value of a bot's input action, held until set again. Events for it are dispatched on the next tick.
+     * @return False if the bot is unknown or the tag has no input action registered.
+     */
+    bool SetBotInputActionValue(const FISBotInputHandle& inHandle, const FGameplayTag& inTag, const FVector& inValue);
+
+    /**
+     * @return The value of a bot's input action as of the last tick.
+     */
+    FInputActionValue GetBotInputActionValue(const FISBotInputHandle& inHandle, const FGameplayTag& inTag) const;
+
+    FORCEINLINE int32 GetNumBots() const
+    {
+        return NumBots;
+    }
+
+protected:
+
+    bool IsBotHandleValid(const FISBotInputHandle& inHandle) const;
+
+    /**
+     * @return The index of the input action's column, creating it if needed. `INDEX_NONE` if the tag has no input action.
+     */
+    int32 FindOrAddActionColumn(const FGameplayTag& inTag);
+
+    /**
+     * @brief Point the tag's column at the newly added input action, since the one it had may have been unloaded.
+     */
+    void OnActionColumnInputActionAdded(const FGameplayTag& inTag, const UInputAction& inInputAction);
+
+    /**
+     * @brief Stop using the tag's column until its input action is added again, dropping all bots' values for it.
+     */
+    void OnActionColumnInputActionRemoved(const FGameplayTag& inTag, const UInputAction& inInputAction);
+
+    /**
+     * @brief Apply pending values and produce trigger events for all bots, in parallel.
+     */
+    void EvaluateActionColumns();
+
+    /**
+     * @brief Call bots' delegates with the trigger events produced by `EvaluateActionColumns()`.
+     */
+    void DispatchTriggerEvents();
+
+protected:
+
+    /**
+     * @brief Number of bots evaluated by each parallel task.
+     */
+    UPROPERTY(EditDefaultsOnly, Config, Category = "InputSetup", meta = (ClampMin = "1"))
+    int32 BotsPerParallelBatch;
+
+protected:
+
+    // Per-bot data, indexed by bot index.
+    TArray<TWeakObjectPtr<APawn>> BotPawns;
+    TArray<FISBotInputActionEventNativeDelegate> BotEventDelegates;
+    TArray<uint32> BotSerials;
+    TBitArray<> BotActiveFlags;
+
+    /**
+     * @brief Bot indices available for reuse.
+     */
+    TArray<int32> FreeBotIndices;
+
+    int32 NumBots = 0;
+
+    /**
+     * @brief Per-input-action data for all bots.
+     */
+    TArray<FISBotInputActionColumn> ActionColumns;
+
+    TMap<FGameplayTag, int32> ActionColumnIndices;
+};
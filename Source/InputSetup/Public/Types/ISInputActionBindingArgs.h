@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "InputTriggers.h"
+
+#include "ISInputActionBindingArgs.generated.h"
+
+/**
+ * @brief Arguments to bind an input action, looked up by gameplay tag, to a function of the owner pawn.
+ *        Corresponds to `UEnhancedInputComponent::BindAction()`.
+ */
+USTRUCT(BlueprintType)
+struct INPUTSETUP_API FISInputActionBindingArgs
+{
+    GENERATED_BODY()
+
+public:
+
+    UPROPERTY(EditAnywhere, meta = (Categories = "InputAction"))
+    FGameplayTag InputActionTag;
+
+    UPROPERTY(EditAnywhere)
+    ETriggerEvent TriggerEvent = ETriggerEvent::Triggered;
+
+    /**
+     * @brief Name of the owner pawn's UFUNCTION to call.
+     */
+    UPROPERTY(EditAnywhere)
+    FName FunctionName;
+};
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayTagContainer.h"
+#include "Types/ISInputMappingContextAddArgs.h"
+
+#include "ISInputMappingContextTagRule.generated.h"
+
+/**
+ * @brief An input mapping context to have added while the owner has the required gameplay tags and none of the blocked ones.
+ */
+USTRUCT(BlueprintType)
+struct INPUTSETUP_API FISInputMappingContextTagRule
+{
+    GENERATED_BODY()
+
+public:
+
+    bool DoesMatch(const FGameplayTagContainer& inOwnerTags) const;
+
+public:
+
+    UPROPERTY(EditAnywhere)
+    FGameplayTagContainer RequiredTags;
+
+    UPROPERTY(EditAnywhere)
+    FGameplayTagContainer BlockedTags;
+
+    UPROPERTY(EditAnywhere)
+    FISInputMappingContextAddArgs InputMappingContextAddArgs;
+};